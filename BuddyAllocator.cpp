@@ -0,0 +1,134 @@
+#include "BuddyAllocator.h"
+#include <algorithm>
+
+BuddyAllocator::BuddyAllocator()
+    : minBlockSize(1), maxOrder(-1), freeBytes(0), internalFragmentation(0) {
+}
+
+void BuddyAllocator::reset(int totalSize, int minBlock) {
+    // The smallest block must itself be a power of two for buddy addressing
+    minBlockSize = 1;
+    while (minBlockSize < minBlock) {
+        minBlockSize <<= 1;
+    }
+
+    maxOrder = -1;
+    while (totalSize > 0 && blockSize(maxOrder + 1) <= totalSize) {
+        maxOrder++;
+    }
+
+    freeLists.assign(maxOrder + 1, {});
+    allocations.clear();
+    freeBytes = 0;
+    internalFragmentation = 0;
+
+    // Greedy descending split keeps every top-level block aligned to its size;
+    // a tail smaller than minBlockSize is left unmanaged
+    int address = 0;
+    for (int order = maxOrder; order >= 0; --order) {
+        if (totalSize - address >= blockSize(order)) {
+            freeLists[order].insert(address);
+            address += blockSize(order);
+            freeBytes += blockSize(order);
+        }
+    }
+}
+
+int BuddyAllocator::orderFor(int size) const {
+    for (int order = 0; order <= maxOrder; ++order) {
+        if (blockSize(order) >= size) {
+            return order;
+        }
+    }
+    return -1;
+}
+
+int BuddyAllocator::allocate(int size) {
+    if (size <= 0) {
+        return -1;
+    }
+    int order = orderFor(size);
+    if (order == -1) {
+        return -1;
+    }
+
+    int available = order;
+    while (available <= maxOrder && freeLists[available].empty()) {
+        available++;
+    }
+    if (available > maxOrder) {
+        return -1;
+    }
+
+    // Lowest address first keeps placement deterministic
+    int address = *freeLists[available].begin();
+    freeLists[available].erase(freeLists[available].begin());
+
+    // Split down, returning each upper half to the free list of its order
+    while (available > order) {
+        available--;
+        freeLists[available].insert(address + blockSize(available));
+    }
+
+    allocations[address] = {order, size};
+    freeBytes -= blockSize(order);
+    internalFragmentation += blockSize(order) - size;
+    return address;
+}
+
+void BuddyAllocator::release(int address) {
+    auto it = allocations.find(address);
+    if (it == allocations.end()) {
+        return;
+    }
+    int order = it->second.order;
+    freeBytes += blockSize(order);
+    internalFragmentation -= blockSize(order) - it->second.requested;
+    allocations.erase(it);
+
+    // Merge with the buddy for as long as the buddy is free at the same order
+    while (order < maxOrder) {
+        int buddy = address ^ blockSize(order);
+        if (freeLists[order].erase(buddy) == 0) {
+            break;
+        }
+        address = std::min(address, buddy);
+        order++;
+    }
+    freeLists[order].insert(address);
+}
+
+bool BuddyAllocator::canAllocate(int size) const {
+    int order = orderFor(size);
+    if (order == -1) {
+        return false;
+    }
+    for (int available = order; available <= maxOrder; ++available) {
+        if (!freeLists[available].empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int BuddyAllocator::largestFreeBlock() const {
+    for (int order = maxOrder; order >= 0; --order) {
+        if (!freeLists[order].empty()) {
+            return blockSize(order);
+        }
+    }
+    return 0;
+}
+
+int BuddyAllocator::allocatedBlockSize(int address) const {
+    auto it = allocations.find(address);
+    return (it != allocations.end()) ? blockSize(it->second.order) : 0;
+}
+
+void BuddyAllocator::forEachFree(const std::function<void(int, int)>& visit) const {
+    for (int order = 0; order <= maxOrder; ++order) {
+        for (int address : freeLists[order]) {
+            visit(address, blockSize(order));
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef BUDDY_ALLOCATOR_H
+#define BUDDY_ALLOCATOR_H
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <functional>
+
+// Binary buddy allocator for the flat MemoryManager (hole-fit-policy buddy)
+// and, in frame units, for the VirtualMemoryManager's frames and huge pages.
+// Blocks are minBlockSize << order bytes and aligned to their own size, so a
+// block's buddy is found by flipping one address bit and coalescing on release
+// is a walk up the orders. Requests are rounded up to the next block size; the
+// rounding slack is reported as internal fragmentation.
+// Not thread-safe; each owner serializes access under its own mutex.
+class BuddyAllocator {
+private:
+    struct Allocation {
+        int order;
+        int requested;
+    };
+
+    int minBlockSize;
+    int maxOrder;
+    int freeBytes;
+    int internalFragmentation;
+    std::vector<std::set<int>> freeLists;               // Free block addresses per order
+    std::unordered_map<int, Allocation> allocations;    // Start address -> allocation
+
+    int blockSize(int order) const { return minBlockSize << order; }
+    int orderFor(int size) const;   // Smallest order that holds size bytes, -1 if none
+
+public:
+    BuddyAllocator();
+
+    // Rebuild the arena; a total that is not a power of two is covered by
+    // descending power-of-two top-level blocks, each its own buddy tree
+    void reset(int totalSize, int minBlock);
+
+    // Start address of a block of at least size bytes, or -1
+    int allocate(int size);
+    void release(int address);
+
+    bool canAllocate(int size) const;
+    int largestFreeBlock() const;
+    int getFreeBytes() const { return freeBytes; }
+    int getInternalFragmentation() const { return internalFragmentation; }
+
+    // Size of the block backing the allocation at address, or 0
+    int allocatedBlockSize(int address) const;
+
+    // Visit (address, size) of every free block
+    void forEachFree(const std::function<void(int, int)>& visit) const;
+};
+
+#endif
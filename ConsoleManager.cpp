@@ -109,10 +109,14 @@ std::string ConsoleManager::extractCommandValue(const std::string& command, cons
 
 
 bool ConsoleManager::loadConfig(const std::string& filename) {
+    return loadConfig(filename, config);
+}
+
+bool ConsoleManager::loadConfig(const std::string& filename, Config& cfg) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        config.errorMessage = "Could not open config file: " + filename;
-        config.isValid = false;
+        cfg.errorMessage = "Could not open config file: " + filename;
+        cfg.isValid = false;
         return false;
     }
     
@@ -125,36 +129,55 @@ bool ConsoleManager::loadConfig(const std::string& filename) {
         if (!(iss >> key >> value)) continue;
         
         if (key == "num-cpu") {
-            config.numCpu = std::stoi(value);
+            cfg.numCpu = std::stoi(value);
         } else if (key == "scheduler") {
             value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
-            config.scheduler = value;
+            cfg.scheduler = value;
         } else if (key == "quantum-cycles") {
-            config.quantumCycles = std::stoi(value);
+            cfg.quantumCycles = std::stoi(value);
         } else if (key == "batch-process-freq") {
-            config.batchProcessFreq = std::stoi(value);
+            cfg.batchProcessFreq = std::stoi(value);
+        } else if (key == "batch-size") {
+            cfg.batchSize = std::stoi(value);
+        } else if (key == "arrival-process") {
+            cfg.arrivalProcess = value;
+        } else if (key == "arrival-trace") {
+            value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
+            cfg.arrivalTrace = value;
         } else if (key == "min-ins") {
-            config.minIns = std::stoi(value);
+            cfg.minIns = std::stoi(value);
         } else if (key == "max-ins") {
-            config.maxIns = std::stoi(value);
+            cfg.maxIns = std::stoi(value);
         } else if (key == "delay-per-exec") {
-            config.delaysPerExec = std::stoi(value);
+            cfg.delaysPerExec = std::stoi(value);
+        } else if (key == "cpu-tick-ms") {
+            cfg.cpuTickMs = std::stoi(value);
         } else if (key == "max-overall-mem") {
-            config.maxOverallMem = std::stoi(value);
+            cfg.maxOverallMem = std::stoi(value);
         } else if (key == "mem-per-frame") {
-            config.memPerFrame = std::stoi(value);
+            cfg.memPerFrame = std::stoi(value);
         } else if (key == "mem-per-proc") {
-            config.memPerProc = std::stoi(value);
+            cfg.memPerProc = std::stoi(value);
         } else if (key == "hole-fit-policy") {
-            config.holeFitPolicy = value;
+            cfg.holeFitPolicy = value;
+        } else if (key == "admission-policy") {
+            cfg.admissionPolicy = value;
         } else if (key == "enable-virtual-memory") {
-            config.enableVirtualMemory = (value == "true" || value == "1");
+            cfg.enableVirtualMemory = (value == "true" || value == "1");
         } else if (key == "min-mem-per-proc") {
-            config.minMemPerProc = std::stoi(value);
+            cfg.minMemPerProc = std::stoi(value);
         } else if (key == "max-mem-per-proc") {
-            config.maxMemPerProc = std::stoi(value);
+            cfg.maxMemPerProc = std::stoi(value);
         } else if (key == "page-replacement-alg") {
-            config.pageReplacementAlg = value;
+            cfg.pageReplacementAlg = value;
+        } else if (key == "backing-store-sync") {
+            cfg.backingStoreSync = value;
+        } else if (key == "backing-store-compact") {
+            cfg.backingStoreCompact = (value == "true" || value == "1");
+        } else if (key == "huge-page-size") {
+            cfg.hugePageSize = std::stoi(value);
+        } else if (key == "huge-page-threshold") {
+            cfg.hugePageThreshold = std::stoi(value);
         }
     }
     
@@ -162,114 +185,184 @@ bool ConsoleManager::loadConfig(const std::string& filename) {
     
     // For Phase 2: If min-mem-per-proc and max-mem-per-proc are set but mem-per-proc is not,
     // use min-mem-per-proc as the base memory per process
-    if (config.memPerProc == 4096 && config.minMemPerProc > 0 && config.maxMemPerProc > 0) {
-        config.memPerProc = config.minMemPerProc;
+    if (cfg.memPerProc == 4096 && cfg.minMemPerProc > 0 && cfg.maxMemPerProc > 0) {
+        cfg.memPerProc = cfg.minMemPerProc;
     }
     
-    return validateConfig();
+    return validateConfig(cfg);
 }
 
-bool ConsoleManager::validateConfig() {
+bool ConsoleManager::validateConfig(Config& cfg) {
     // Validate num-cpu if within 1 - 128
-    if (config.numCpu < 1 || config.numCpu > 128) {
-        config.errorMessage = "num-cpu must be between 1 and 128. Got: " + std::to_string(config.numCpu);
-        config.isValid = false;
+    if (cfg.numCpu < 1 || cfg.numCpu > 128) {
+        cfg.errorMessage = "num-cpu must be between 1 and 128. Got: " + std::to_string(cfg.numCpu);
+        cfg.isValid = false;
         return false;
     }
     
     // Checks if valid scheduler choice
-    if (config.scheduler != "fcfs" && config.scheduler != "rr") {
-        config.errorMessage = "scheduler must be 'fcfs' or 'rr'. Got: " + config.scheduler;
-        config.isValid = false;
+    if (cfg.scheduler != "fcfs" && cfg.scheduler != "rr") {
+        cfg.errorMessage = "scheduler must be 'fcfs' or 'rr'. Got: " + cfg.scheduler;
+        cfg.isValid = false;
         return false;
     }
     
     // Checks if quantum-cycles is valid (0 is allowed for FCFS)
-    if (config.quantumCycles < 0) {
-        config.errorMessage = "quantum-cycles must be >= 0. Got: " + std::to_string(config.quantumCycles);
-        config.isValid = false;
+    if (cfg.quantumCycles < 0) {
+        cfg.errorMessage = "quantum-cycles must be >= 0. Got: " + std::to_string(cfg.quantumCycles);
+        cfg.isValid = false;
         return false;
     }
     
     // Validate batch-process-freq
-    if (config.batchProcessFreq < 1) {
-        config.errorMessage = "batch-process-freq must be >= 1. Got: " + std::to_string(config.batchProcessFreq);
-        config.isValid = false;
+    if (cfg.batchProcessFreq < 1) {
+        cfg.errorMessage = "batch-process-freq must be >= 1. Got: " + std::to_string(cfg.batchProcessFreq);
+        cfg.isValid = false;
+        return false;
+    }
+    
+    // Validate batch-size and the arrival process
+    if (cfg.batchSize < 1) {
+        cfg.errorMessage = "batch-size must be >= 1. Got: " + std::to_string(cfg.batchSize);
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.arrivalProcess != "fixed" && cfg.arrivalProcess != "poisson" &&
+        cfg.arrivalProcess != "bursty" && cfg.arrivalProcess != "trace") {
+        cfg.errorMessage = "arrival-process must be 'fixed', 'poisson', 'bursty' or 'trace'. Got: " + cfg.arrivalProcess;
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.arrivalProcess == "trace" && cfg.arrivalTrace.empty()) {
+        cfg.errorMessage = "arrival-process 'trace' needs an arrival-trace file";
+        cfg.isValid = false;
+        return false;
+    }
+    
+    // Validate delay-per-exec and cpu-tick-ms [0, ∞]
+    if (cfg.delaysPerExec < 0) {
+        cfg.errorMessage = "delay-per-exec must be >= 0. Got: " + std::to_string(cfg.delaysPerExec);
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.cpuTickMs < 0) {
+        cfg.errorMessage = "cpu-tick-ms must be >= 0. Got: " + std::to_string(cfg.cpuTickMs);
+        cfg.isValid = false;
         return false;
     }
     
     // Validate min-ins [1, ∞]
-    if (config.minIns < 1) {
-        config.errorMessage = "min-ins must be >= 1. Got: " + std::to_string(config.minIns);
-        config.isValid = false;
+    if (cfg.minIns < 1) {
+        cfg.errorMessage = "min-ins must be >= 1. Got: " + std::to_string(cfg.minIns);
+        cfg.isValid = false;
         return false;
     }
     
     // Validate max-ins [1, ∞] and max-ins >= min-ins
-    if (config.maxIns < 1) {
-        config.errorMessage = "max-ins must be >= 1. Got: " + std::to_string(config.maxIns);
-        config.isValid = false;
+    if (cfg.maxIns < 1) {
+        cfg.errorMessage = "max-ins must be >= 1. Got: " + std::to_string(cfg.maxIns);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.maxIns < config.minIns) {
-        config.errorMessage = "max-ins must be >= min-ins. Got max: " + std::to_string(config.maxIns) + ", min: " + std::to_string(config.minIns);
-        config.isValid = false;
+    if (cfg.maxIns < cfg.minIns) {
+        cfg.errorMessage = "max-ins must be >= min-ins. Got max: " + std::to_string(cfg.maxIns) + ", min: " + std::to_string(cfg.minIns);
+        cfg.isValid = false;
         return false;
     }
     
     // Validate memory parameters
-    if (config.maxOverallMem < 1) {
-        config.errorMessage = "max-overall-mem must be >= 1. Got: " + std::to_string(config.maxOverallMem);
-        config.isValid = false;
+    if (cfg.maxOverallMem < 1) {
+        cfg.errorMessage = "max-overall-mem must be >= 1. Got: " + std::to_string(cfg.maxOverallMem);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.memPerFrame < 1) {
-        config.errorMessage = "mem-per-frame must be >= 1. Got: " + std::to_string(config.memPerFrame);
-        config.isValid = false;
+    if (cfg.memPerFrame < 1) {
+        cfg.errorMessage = "mem-per-frame must be >= 1. Got: " + std::to_string(cfg.memPerFrame);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.memPerProc < 1) {
-        config.errorMessage = "mem-per-proc must be >= 1. Got: " + std::to_string(config.memPerProc);
-        config.isValid = false;
+    if (cfg.memPerProc < 1) {
+        cfg.errorMessage = "mem-per-proc must be >= 1. Got: " + std::to_string(cfg.memPerProc);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.memPerProc > config.maxOverallMem) {
-        config.errorMessage = "mem-per-proc cannot be larger than max-overall-mem. Got mem-per-proc: " + 
-                              std::to_string(config.memPerProc) + ", max-overall-mem: " + std::to_string(config.maxOverallMem);
-        config.isValid = false;
+    if (cfg.memPerProc > cfg.maxOverallMem) {
+        cfg.errorMessage = "mem-per-proc cannot be larger than max-overall-mem. Got mem-per-proc: " + 
+                              std::to_string(cfg.memPerProc) + ", max-overall-mem: " + std::to_string(cfg.maxOverallMem);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.holeFitPolicy != "F" && config.holeFitPolicy != "B" && config.holeFitPolicy != "W") {
-        config.errorMessage = "hole-fit-policy must be 'F' (First-fit), 'B' (Best-fit), or 'W' (Worst-fit). Got: " + config.holeFitPolicy;
-        config.isValid = false;
+    if (cfg.holeFitPolicy != "F" && cfg.holeFitPolicy != "N" &&
+        cfg.holeFitPolicy != "B" && cfg.holeFitPolicy != "W" && cfg.holeFitPolicy != "buddy") {
+        cfg.errorMessage = "hole-fit-policy must be 'F' (First-fit), 'N' (Next-fit), 'B' (Best-fit), 'W' (Worst-fit), or 'buddy'. Got: " + cfg.holeFitPolicy;
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.admissionPolicy != "fifo" && cfg.admissionPolicy != "smallest" && cfg.admissionPolicy != "priority") {
+        cfg.errorMessage = "admission-policy must be 'fifo', 'smallest' or 'priority'. Got: " + cfg.admissionPolicy;
+        cfg.isValid = false;
         return false;
     }
     
     // Validate Phase 2 parameters
-    if (config.minMemPerProc < 8 || config.minMemPerProc > 65536) {
-        config.errorMessage = "min-mem-per-proc must be between 64 and 65536. Got: " + std::to_string(config.minMemPerProc);
-        config.isValid = false;
+    if (cfg.minMemPerProc < 8 || cfg.minMemPerProc > 65536) {
+        cfg.errorMessage = "min-mem-per-proc must be between 64 and 65536. Got: " + std::to_string(cfg.minMemPerProc);
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.maxMemPerProc < cfg.minMemPerProc || cfg.maxMemPerProc > 65536) {
+        cfg.errorMessage = "max-mem-per-proc must be between min-mem-per-proc and 65536. Got: " + std::to_string(cfg.maxMemPerProc);
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.pageReplacementAlg != "LRU" && cfg.pageReplacementAlg != "FIFO" &&
+        cfg.pageReplacementAlg != "CLOCK" && cfg.pageReplacementAlg != "SECOND-CHANCE" &&
+        cfg.pageReplacementAlg != "LFU" && cfg.pageReplacementAlg != "ARC") {
+        cfg.errorMessage = "page-replacement-alg must be 'LRU', 'FIFO', 'CLOCK', 'SECOND-CHANCE', 'LFU' or 'ARC'. Got: " + cfg.pageReplacementAlg;
+        cfg.isValid = false;
+        return false;
+    }
+    
+    if (cfg.backingStoreSync != "none" && cfg.backingStoreSync != "batch" && cfg.backingStoreSync != "always") {
+        cfg.errorMessage = "backing-store-sync must be 'none', 'batch' or 'always'. Got: " + cfg.backingStoreSync;
+        cfg.isValid = false;
+        return false;
+    }
+    
+    // Paging splits addresses with a shift and a mask, so page sizes are powers of two
+    if (cfg.enableVirtualMemory && (cfg.memPerFrame & (cfg.memPerFrame - 1)) != 0) {
+        cfg.errorMessage = "mem-per-frame must be a power of two with virtual memory. Got: " + std::to_string(cfg.memPerFrame);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.maxMemPerProc < config.minMemPerProc || config.maxMemPerProc > 65536) {
-        config.errorMessage = "max-mem-per-proc must be between min-mem-per-proc and 65536. Got: " + std::to_string(config.maxMemPerProc);
-        config.isValid = false;
+    if (cfg.hugePageSize != 0 &&
+        (cfg.hugePageSize <= cfg.memPerFrame || (cfg.hugePageSize & (cfg.hugePageSize - 1)) != 0 ||
+         cfg.hugePageSize > cfg.maxOverallMem)) {
+        cfg.errorMessage = "huge-page-size must be 0 or a power of two above mem-per-frame and at most max-overall-mem. Got: " +
+                           std::to_string(cfg.hugePageSize);
+        cfg.isValid = false;
         return false;
     }
     
-    if (config.pageReplacementAlg != "LRU" && config.pageReplacementAlg != "FIFO") {
-        config.errorMessage = "page-replacement-alg must be 'LRU' or 'FIFO'. Got: " + config.pageReplacementAlg;
-        config.isValid = false;
+    if (cfg.hugePageThreshold < 1) {
+        cfg.errorMessage = "huge-page-threshold must be >= 1. Got: " + std::to_string(cfg.hugePageThreshold);
+        cfg.isValid = false;
         return false;
     }
     
-    config.isValid = true;
+    cfg.isValid = true;
     return true;
 }
 
@@ -348,12 +441,18 @@ void ConsoleManager::commandInitialize() {
         std::cout << "  scheduler: " << config.scheduler << "\n";
         std::cout << "  quantum-cycles: " << config.quantumCycles << "\n";
         std::cout << "  batch-process-freq: " << config.batchProcessFreq << "\n";
+        std::cout << "  batch-size: " << config.batchSize << "\n";
+        std::cout << "  arrival-process: " << config.arrivalProcess << "\n";
+        if (config.arrivalProcess == "trace") {
+            std::cout << "  arrival-trace: " << config.arrivalTrace << "\n";
+        }
         std::cout << "  min-ins: " << config.minIns << "\n";
         std::cout << "  max-ins: " << config.maxIns << "\n";
         std::cout << "  max-overall-mem: " << config.maxOverallMem << "\n";
         std::cout << "  mem-per-frame: " << config.memPerFrame << "\n";
         std::cout << "  mem-per-proc: " << config.memPerProc << "\n";
         std::cout << "  hole-fit-policy: " << config.holeFitPolicy << "\n";
+        std::cout << "  admission-policy: " << config.admissionPolicy << "\n";
         
         // Phase 2 parameters
         if (config.enableVirtualMemory) {
@@ -361,6 +460,10 @@ void ConsoleManager::commandInitialize() {
             std::cout << "  min-mem-per-proc: " << config.minMemPerProc << "\n";
             std::cout << "  max-mem-per-proc: " << config.maxMemPerProc << "\n";
             std::cout << "  page-replacement-alg: " << config.pageReplacementAlg << "\n";
+            std::cout << "  backing-store-sync: " << config.backingStoreSync << "\n";
+            std::cout << "  backing-store-compact: " << (config.backingStoreCompact ? "true" : "false") << "\n";
+            std::cout << "  huge-page-size: " << config.hugePageSize << "\n";
+            std::cout << "  huge-page-threshold: " << config.hugePageThreshold << "\n";
         } else {
             std::cout << "  enable-virtual-memory: false (Phase 1 mode)\n";
         }
@@ -393,7 +496,6 @@ void ConsoleManager::commandSchedulerStart() {
             if (processManager->isGeneratingProcesses()) {
                 std::cout << "Stopping existing process generation..." << std::endl;
                 processManager->stopProcessGeneration();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Give it time to stop
             }
             
             // First start the scheduler itself
@@ -1173,8 +1275,10 @@ void ConsoleManager::commandStatus() {
         std::cout << "  Memory per process: " << ptr->memPerProc << " bytes\n";
         std::cout << "  Memory per frame: " << ptr->memPerFrame << " bytes\n";
         std::string policyName = (ptr->holeFitPolicy == "F" ? "First-fit" : 
+                                 (ptr->holeFitPolicy == "N" ? "Next-fit" :
                                  (ptr->holeFitPolicy == "B" ? "Best-fit" : 
-                                 (ptr->holeFitPolicy == "W" ? "Worst-fit" : ptr->holeFitPolicy)));
+                                 (ptr->holeFitPolicy == "W" ? "Worst-fit" :
+                                 (ptr->holeFitPolicy == "buddy" ? "Buddy" : ptr->holeFitPolicy)))));
         std::cout << "  Allocation policy: " << policyName << "\n\n";
     }
     
@@ -1274,6 +1378,12 @@ void ConsoleManager::commandProcessSmi() {
     std::cout << "\nCPU Statistics:\n";
     std::cout << "CPU Cores:        " << processManager->getNumCores() << "\n";
     std::cout << "CPU Utilization:  " << std::fixed << std::setprecision(2) << stats.cpuUtilization << "%\n";
+    
+    // Since the scheduler started, from the per-core tick counters
+    double clockTicks = static_cast<double>(stats.totalCpuTicks) / std::max(1, processManager->getNumCores());
+    std::cout << "Avg Utilization:  " << stats.averageCpuUtilization << "%\n";
+    std::cout << "Instructions:     " << stats.instructionsRetired << "\n";
+    std::cout << "Instr per Tick:   " << (clockTicks > 0 ? stats.instructionsRetired / clockTicks : 0.0) << "\n";
     std::cout << "Running Processes: " << stats.runningProcessCount << "\n";
     std::cout << "Total Processes:   " << stats.totalProcessCount << "\n";
 }
@@ -1304,20 +1414,49 @@ void ConsoleManager::commandVmstat() {
     std::cout << "  CPU Ticks (Active):" << std::setw(10) << stats.activeCpuTicks << "\n";
     std::cout << "  CPU Utilization:   " << std::setw(10) << std::fixed << std::setprecision(2) 
               << stats.cpuUtilization << "%\n";
+    std::cout << "  Avg Utilization:   " << std::setw(10) << stats.averageCpuUtilization << "%\n";
+    std::cout << "  Instructions:      " << std::setw(10) << stats.instructionsRetired << "\n";
+    
+    std::cout << "\nScheduler:\n";
+    std::cout << "  Queued Processes:  " << std::setw(10) << stats.queuedProcessCount << "\n";
+    std::cout << "  Sleeping Processes:" << std::setw(10) << stats.sleepingProcessCount << "\n";
+    std::cout << "  Blocked on I/O:    " << std::setw(10) << stats.blockedProcessCount << "\n";
+    std::cout << "  Waiting for Memory:" << std::setw(10) << stats.admissionQueueLength << "\n";
+    std::cout << "  Work Steals:       " << std::setw(10) << stats.runQueueSteals << "\n";
+    std::cout << "  Queue Depths:      ";
+    for (size_t i = 0; i < stats.runQueueDepths.size(); ++i) {
+        std::cout << (i > 0 ? " " : "") << stats.runQueueDepths[i];
+    }
+    std::cout << "\n";
     
     if (processManager->isVirtualMemoryEnabled()) {
         std::cout << "\nVirtual Memory:\n";
         std::cout << "  Page Faults:      " << std::setw(10) << stats.pageFaults << "\n";
         std::cout << "  Pages In:         " << std::setw(10) << stats.pagesIn << "\n";
         std::cout << "  Pages Out:        " << std::setw(10) << stats.pagesOut << "\n";
+        std::cout << "  Zero-fill Faults: " << std::setw(10) << stats.zeroFillFaults << "\n";
+        std::cout << "  Read-ahead Pages: " << std::setw(10) << stats.prefetchedPages << "\n";
+        std::cout << "  Read-ahead Hits:  " << std::setw(10) << stats.prefetchHits << "\n";
+        std::cout << "  Read-ahead Wasted:" << std::setw(10) << stats.prefetchWasted << "\n";
         
         if (stats.pageFaults > 0) {
             double hitRatio = 1.0 - ((double)stats.pageFaults / (stats.pagesIn + stats.pageFaults));
             std::cout << "  Page Hit Ratio:   " << std::setw(10) << std::fixed << std::setprecision(3) 
                       << hitRatio * 100.0 << "%\n";
         }
+        
+        std::cout << "  Swap File Size:   " << std::setw(10) << stats.backingStoreSize << " bytes\n";
+        std::cout << "  Swap Used:        " << std::setw(10) << stats.backingStoreUsed << " bytes\n";
+        std::cout << "  TLB Hits:         " << std::setw(10) << stats.tlbHits << "\n";
+        std::cout << "  TLB Misses:       " << std::setw(10) << stats.tlbMisses << "\n";
+        if (stats.tlbHits + stats.tlbMisses > 0) {
+            std::cout << "  TLB Hit Ratio:    " << std::setw(10) << std::fixed << std::setprecision(3)
+                      << (double)stats.tlbHits / (stats.tlbHits + stats.tlbMisses) * 100.0 << "%\n";
+        }
     } else {
         std::cout << "\nVirtual Memory: Disabled (Phase 1 mode)\n";
+        std::cout << "  External Fragmentation:" << std::setw(10) << stats.externalFragmentation << " bytes\n";
+        std::cout << "  Internal Fragmentation:" << std::setw(10) << stats.internalFragmentation << " bytes\n";
     }
     
     std::cout << "\nProcess Information:\n";
@@ -1329,17 +1468,30 @@ void ConsoleManager::commandVmstat() {
     auto runningProcesses = processManager->getRunningProcesses();
     if (!runningProcesses.empty()) {
         std::cout << "\nCurrently Running Processes:\n";
-        std::cout << "PID\tName\t\tCore\tMemory (bytes)\n";
-        std::cout << "---\t----\t\t----\t--------------\n";
+        std::cout << "PID\tName\t\tCore\tOn Core (ticks)\tMemory (bytes)\n";
+        std::cout << "---\t----\t\t----\t---------------\t--------------\n";
         
+        auto occupancy = processManager->getCoreOccupancy();
+        uint64_t now = processManager->getClock().now();
         for (const auto& process : runningProcesses) {
             size_t memSize = processManager->isVirtualMemoryEnabled() ? 
                             process->getVirtualMemorySize() : process->getMemorySize();
             
+            int core = -1;
+            for (size_t i = 0; i < occupancy.size(); ++i) {
+                if (occupancy[i].processId == process->getProcessId()) {
+                    core = static_cast<int>(i);
+                }
+            }
+            
             std::cout << process->getProcessId() << "\t" 
-                      << process->getName().substr(0, 12) << "\t" 
-                      << process->getAssignedCore() << "\t" 
-                      << memSize << "\n";
+                      << process->getName().substr(0, 12) << "\t";
+            if (core >= 0) {
+                std::cout << core << "\t" << now - std::min(now, occupancy[core].busySince);
+            } else {
+                std::cout << "-\t-";
+            }
+            std::cout << "\t\t" << memSize << "\n";
         }
     }
 }
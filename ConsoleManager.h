@@ -44,21 +44,30 @@ struct Config {
     std::string scheduler = "rr";
     int quantumCycles = 4;
     int batchProcessFreq = 1;
+    int batchSize = 1;                       // Mean processes created per batch-process-freq period
+    std::string arrivalProcess = "fixed";    // fixed, poisson, bursty or trace: how batch sizes vary
+    std::string arrivalTrace = "";           // Lines of "<tick> [count]" replayed when arrival-process is trace
     int minIns = 100;
     int maxIns = 100;
     int delaysPerExec = 0;
+    int cpuTickMs = 100;                     // Real-time length of a CPU tick, 0 for virtual time
     
     // Memory management parameters
     int maxOverallMem = 16384;
     int memPerFrame = 16;
     int memPerProc = 4096;
     std::string holeFitPolicy = "F"; // F for First-fit
+    std::string admissionPolicy = "fifo";    // fifo, smallest or priority: order of processes waiting for memory
     
     // Phase 2 parameters
     bool enableVirtualMemory = false;        // Enable virtual memory management
     int minMemPerProc = 64;                  // Minimum process memory
     int maxMemPerProc = 4096;                // Maximum process memory
     std::string pageReplacementAlg = "LRU";  // Page replacement algorithm
+    std::string backingStoreSync = "none";   // none, batch or always: when page-outs are fsync'ed
+    bool backingStoreCompact = true;         // Truncate the swap file as processes release memory
+    int hugePageSize = 0;                    // Page size for large processes, 0 to turn huge pages off
+    int hugePageThreshold = 4096;            // Process size from which huge pages are used
     
     bool isValid = false;
     std::string errorMessage = "";
@@ -80,7 +89,6 @@ private:
     Config config;
     bool loadConfig(const std::string& filename);
     bool loadConfig(Config& cfg);
-    bool validateConfig();
     Config* getOSConfig() { return &config; }
 
     // Private helper methods
@@ -108,6 +116,11 @@ private:
 public:
     ConsoleManager();
     ~ConsoleManager();
+    
+    // Config parsing, shared with the headless simulator
+    static bool loadConfig(const std::string& filename, Config& cfg);
+    static bool validateConfig(Config& cfg);
+    
     void clearScreen();
     void printHeader();
     void commandHelp();
@@ -0,0 +1,96 @@
+#include "CpuClock.h"
+#include <thread>
+#include <algorithm>
+
+CpuClock::CpuClock() : currentTick(0), participants(0), arrived(0),
+    tickPeriod(100), nextDeadline(std::chrono::steady_clock::now()), nextListenerId(0) {
+}
+
+void CpuClock::setTickPeriod(int milliseconds) {
+    std::lock_guard<std::mutex> lock(clockMutex);
+    tickPeriod = std::chrono::milliseconds(std::max(0, milliseconds));
+    nextDeadline = std::chrono::steady_clock::now() + tickPeriod;
+}
+
+int CpuClock::getTickPeriod() const {
+    std::lock_guard<std::mutex> lock(clockMutex);
+    return static_cast<int>(tickPeriod.count());
+}
+
+void CpuClock::join() {
+    std::lock_guard<std::mutex> lock(clockMutex);
+    if (participants == 0) {
+        // Nothing drove the clock while no core was registered, so restart the pacing
+        nextDeadline = std::chrono::steady_clock::now() + tickPeriod;
+    }
+    participants++;
+}
+
+void CpuClock::leave() {
+    std::lock_guard<std::mutex> lock(clockMutex);
+    participants--;
+
+    // The departing core may have been the last one the others were waiting for
+    if (participants > 0 && arrived >= participants) {
+        advanceLocked();
+    } else if (participants == 0) {
+        arrived = 0;
+        tickCv.notify_all();
+    }
+}
+
+void CpuClock::tick() {
+    std::unique_lock<std::mutex> lock(clockMutex);
+    uint64_t tickAtArrival = currentTick;
+
+    arrived++;
+    if (arrived >= participants) {
+        advanceLocked();
+        return;
+    }
+
+    tickCv.wait(lock, [this, tickAtArrival]() { return currentTick != tickAtArrival; });
+}
+
+void CpuClock::waitTicks(uint64_t ticks) {
+    std::unique_lock<std::mutex> lock(clockMutex);
+    uint64_t target = currentTick + ticks;
+    tickCv.wait(lock, [this, target]() { return currentTick >= target || participants == 0; });
+}
+
+int CpuClock::addTickListener(std::function<void(uint64_t)> listener) {
+    std::lock_guard<std::mutex> lock(clockMutex);
+    int id = nextListenerId++;
+    listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void CpuClock::removeTickListener(int id) {
+    // Taking the lock also waits out a listener that is running right now
+    std::lock_guard<std::mutex> lock(clockMutex);
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+        [id](const auto& entry) { return entry.first == id; }), listeners.end());
+}
+
+void CpuClock::advanceLocked() {
+    // Called with clockMutex held by the last core to arrive
+    arrived = 0;
+
+    if (tickPeriod.count() > 0) {
+        // The lock is held while pacing, so no core can join or arrive mid-tick
+        auto now = std::chrono::steady_clock::now();
+        if (nextDeadline + tickPeriod < now) {
+            nextDeadline = now;     // Fell behind, do not try to catch up in a burst
+        }
+        std::this_thread::sleep_until(nextDeadline);
+        nextDeadline += tickPeriod;
+    }
+
+    uint64_t tick = currentTick + 1;
+    for (auto& entry : listeners) {
+        entry.second(tick);
+    }
+
+    currentTick = tick;
+    tickCv.notify_all();
+}
@@ -0,0 +1,57 @@
+#ifndef CPUCLOCK_H
+#define CPUCLOCK_H
+
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+
+// Global simulated tick source shared by all CPU cores.
+// Every registered core calls tick() once per cycle, busy or idle; the last
+// core to arrive runs the tick listeners (timer wheel, process generator) and
+// starts the next tick, so all cores advance in lock-step. With a tick period
+// of 0 the clock runs in virtual time and ticks as fast as the cores allow.
+class CpuClock {
+private:
+    mutable std::mutex clockMutex;
+    std::condition_variable tickCv;
+    std::atomic<uint64_t> currentTick;
+    int participants;
+    int arrived;
+
+    std::chrono::milliseconds tickPeriod;
+    std::chrono::steady_clock::time_point nextDeadline;
+
+    int nextListenerId;
+    std::vector<std::pair<int, std::function<void(uint64_t)>>> listeners;
+
+    void advanceLocked();
+
+public:
+    CpuClock();
+
+    // Tick length in real time; 0 selects fast-as-possible virtual time
+    void setTickPeriod(int milliseconds);
+    int getTickPeriod() const;
+    uint64_t now() const { return currentTick; }
+
+    // Cores register for lock-step before their first tick and leave when they exit
+    void join();
+    void leave();
+
+    // Arrive at the end of the current tick and wait for the next one
+    void tick();
+
+    // Block a non-participating thread for the given ticks; returns early if no core drives the clock
+    void waitTicks(uint64_t ticks);
+
+    // Listeners run on a core thread with the clock locked, once per tick, and must not join, leave or wait on the clock
+    int addTickListener(std::function<void(uint64_t)> listener);
+    void removeTickListener(int id);
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "HoleIndex.h"
+#include <algorithm>
+
+HoleIndex::HoleIndex() : root(NIL), rngState(0x9E3779B9u) {
+}
+
+void HoleIndex::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    bySize.clear();
+    root = NIL;
+}
+
+int HoleIndex::newNode(int address, int size) {
+    // xorshift32 priorities keep the treap balanced in expectation
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+
+    Node node{address, size, size, rngState, NIL, NIL};
+    if (!freeNodes.empty()) {
+        int index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void HoleIndex::update(int node) {
+    Node& n = nodes[node];
+    n.maxSize = n.size;
+    if (n.left != NIL) {
+        n.maxSize = std::max(n.maxSize, nodes[n.left].maxSize);
+    }
+    if (n.right != NIL) {
+        n.maxSize = std::max(n.maxSize, nodes[n.right].maxSize);
+    }
+}
+
+void HoleIndex::split(int node, int address, int& left, int& right) {
+    // left gets addresses below the split point, right the rest
+    if (node == NIL) {
+        left = right = NIL;
+        return;
+    }
+    if (nodes[node].address < address) {
+        split(nodes[node].right, address, nodes[node].right, right);
+        left = node;
+    } else {
+        split(nodes[node].left, address, left, nodes[node].left);
+        right = node;
+    }
+    update(node);
+}
+
+int HoleIndex::merge(int left, int right) {
+    // Every address in left is below every address in right
+    if (left == NIL) return right;
+    if (right == NIL) return left;
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+}
+
+void HoleIndex::insert(int address, int size) {
+    if (size <= 0) {
+        return;
+    }
+    int left, right;
+    split(root, address, left, right);
+    root = merge(merge(left, newNode(address, size)), right);
+    bySize.insert({size, address});
+}
+
+void HoleIndex::erase(int address) {
+    int left, middle, right;
+    split(root, address, left, right);
+    split(right, address + 1, middle, right);
+    if (middle != NIL) {
+        bySize.erase({nodes[middle].size, address});
+        freeNodes.push_back(middle);
+    }
+    root = merge(left, right);
+}
+
+int HoleIndex::sizeAt(int address) const {
+    int node = root;
+    while (node != NIL) {
+        const Node& n = nodes[node];
+        if (address == n.address) {
+            return n.size;
+        }
+        node = (address < n.address) ? n.left : n.right;
+    }
+    return 0;
+}
+
+int HoleIndex::predecessor(int address) const {
+    int result = -1;
+    int node = root;
+    while (node != NIL) {
+        const Node& n = nodes[node];
+        if (n.address < address) {
+            result = n.address;
+            node = n.right;
+        } else {
+            node = n.left;
+        }
+    }
+    return result;
+}
+
+int HoleIndex::firstFitFrom(int node, int size, int fromAddress) const {
+    // Subtrees whose largest hole is too small are skipped without being visited
+    if (node == NIL || nodes[node].maxSize < size) {
+        return -1;
+    }
+    const Node& n = nodes[node];
+    if (n.address < fromAddress) {
+        return firstFitFrom(n.right, size, fromAddress);
+    }
+    int found = firstFitFrom(n.left, size, fromAddress);
+    if (found != -1) {
+        return found;
+    }
+    if (n.size >= size) {
+        return n.address;
+    }
+    return firstFitFrom(n.right, size, fromAddress);
+}
+
+int HoleIndex::firstFit(int size, int fromAddress) const {
+    return firstFitFrom(root, size, fromAddress);
+}
+
+int HoleIndex::bestFit(int size) const {
+    auto it = bySize.lower_bound({size, -1});
+    return (it != bySize.end()) ? it->second : -1;
+}
+
+int HoleIndex::worstFit(int size) const {
+    if (bySize.empty() || bySize.rbegin()->first < size) {
+        return -1;
+    }
+    // Among equally large holes prefer the lowest address
+    auto it = bySize.lower_bound({bySize.rbegin()->first, -1});
+    return it->second;
+}
+
+int HoleIndex::largest() const {
+    return bySize.empty() ? 0 : bySize.rbegin()->first;
+}
+
+void HoleIndex::forEachInOrder(int node, const std::function<void(int, int)>& visit) const {
+    if (node == NIL) {
+        return;
+    }
+    forEachInOrder(nodes[node].left, visit);
+    visit(nodes[node].address, nodes[node].size);
+    forEachInOrder(nodes[node].right, visit);
+}
+
+void HoleIndex::forEach(const std::function<void(int, int)>& visit) const {
+    forEachInOrder(root, visit);
+}
@@ -0,0 +1,71 @@
+#ifndef HOLE_INDEX_H
+#define HOLE_INDEX_H
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+// Index of free memory holes for the MemoryManager.
+// Holes live in two orders at once:
+//  - a treap keyed by start address, where each node also tracks the largest
+//    hole in its subtree, so first-fit and next-fit descend in O(log n)
+//  - a (size, address) ordered set for best-fit and worst-fit in O(log n)
+// Neighbour lookups for coalescing are O(log n) searches on the address treap.
+class HoleIndex {
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        int address;
+        int size;
+        int maxSize;        // Largest hole in this subtree
+        uint32_t priority;
+        int left;
+        int right;
+    };
+
+    std::vector<Node> nodes;        // Node pool, indices instead of pointers
+    std::vector<int> freeNodes;     // Recycled pool slots
+    int root;
+    uint32_t rngState;
+    std::set<std::pair<int, int>> bySize;   // (size, address)
+
+    int newNode(int address, int size);
+    void update(int node);
+    void split(int node, int address, int& left, int& right);
+    int merge(int left, int right);
+    int firstFitFrom(int node, int size, int fromAddress) const;
+    void forEachInOrder(int node, const std::function<void(int, int)>& visit) const;
+
+public:
+    HoleIndex();
+
+    void clear();
+    void insert(int address, int size);
+    void erase(int address);
+    bool empty() const { return bySize.empty(); }
+    size_t count() const { return bySize.size(); }
+
+    // Size of the hole starting at address, or 0 if there is none
+    int sizeAt(int address) const;
+
+    // Start of the hole with the greatest address below the given one, or -1
+    int predecessor(int address) const;
+
+    // Placement queries; each returns the start address of a hole of at least size bytes, or -1
+    int firstFit(int size, int fromAddress = 0) const;  // Lowest address at or above fromAddress
+    int bestFit(int size) const;                        // Smallest hole that fits
+    int worstFit(int size) const;                       // Largest hole
+
+    int largest() const;
+
+    // Holes in ascending size order, for fragmentation statistics
+    const std::set<std::pair<int, int>>& holesBySize() const { return bySize; }
+
+    // Visit (address, size) of every hole in address order
+    void forEach(const std::function<void(int, int)>& visit) const;
+};
+
+#endif
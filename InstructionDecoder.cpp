@@ -0,0 +1,332 @@
+#include "InstructionDecoder.h"
+#include <sstream>
+#include <algorithm>
+
+DecodedProgram InstructionDecoder::decode(const std::vector<std::string>& instructions) {
+    program = DecodedProgram();
+    symbolIndex.clear();
+    program.code.reserve(instructions.size());
+    program.listing.reserve(instructions.size());
+
+    for (const auto& instruction : instructions) {
+        program.unrolledLength += decodeStatement(instruction, 0);
+    }
+
+    return std::move(program);
+}
+
+uint64_t InstructionDecoder::decodeStatement(const std::string& instruction, int loopDepth) {
+    if (instruction.find("FOR(") == 0) {
+        return decodeFor(instruction, loopDepth);
+    }
+
+    program.code.push_back(decodeInstruction(instruction));
+    program.listing.push_back(instruction);
+    return 1;
+}
+
+uint64_t InstructionDecoder::decodeFor(const std::string& instruction, int loopDepth) {
+    // FOR(stmt;stmt;..., count), where a statement may itself be a FOR
+    std::vector<std::string> args;
+    size_t end = instruction.rfind(')');
+    if (end != std::string::npos && end > 4) {
+        args = splitTopLevel(instruction.substr(4, end - 4), ',');
+    }
+
+    int iterations = 0;
+    std::vector<std::string> body;
+    if (args.size() == 2) {
+        try {
+            iterations = std::stoi(trim(args[1]));
+        } catch (...) {
+            iterations = 0;
+        }
+        for (const auto& statement : splitTopLevel(args[0], ';')) {
+            std::string trimmed = trim(statement);
+            if (!trimmed.empty()) {
+                body.push_back(trimmed);
+            }
+        }
+    }
+
+    // Malformed, empty, zero-count or too deeply nested loops execute as a single no-op
+    if (loopDepth >= MAX_LOOP_DEPTH || iterations <= 0 || body.empty()) {
+        program.code.push_back(DecodedInstruction());
+        program.listing.push_back(instruction);
+        return 1;
+    }
+
+    uint32_t beginIndex = static_cast<uint32_t>(program.code.size());
+    DecodedInstruction loopBegin;
+    loopBegin.op = OpCode::FOR_BEGIN;
+    loopBegin.aux = static_cast<uint32_t>(iterations);
+    program.code.push_back(loopBegin);
+    program.listing.push_back(instruction);
+
+    uint64_t bodyLength = 0;
+    for (const auto& statement : body) {
+        bodyLength += decodeStatement(statement, loopDepth + 1);
+    }
+
+    DecodedInstruction loopEnd;
+    loopEnd.op = OpCode::FOR_END;
+    loopEnd.aux = beginIndex + 1;
+    program.code.push_back(loopEnd);
+    program.listing.push_back("END FOR");
+
+    return bodyLength * static_cast<uint64_t>(iterations);
+}
+
+DecodedInstruction InstructionDecoder::decodeInstruction(const std::string& instruction) {
+    DecodedInstruction decoded;
+
+    if (instruction.find("PRINT(") == 0) {
+        decodePrint(instruction, decoded);
+    }
+    else if (instruction.find("DECLARE(") == 0) {
+        decodeDeclare(instruction, decoded);
+    }
+    else if (instruction.find("ADD(") == 0) {
+        decoded.op = OpCode::ADD;
+        decodeArithmetic(instruction, decoded);
+    }
+    else if (instruction.find("SUBTRACT(") == 0) {
+        decoded.op = OpCode::SUBTRACT;
+        decodeArithmetic(instruction, decoded);
+    }
+    else if (instruction.find("SLEEP(") == 0) {
+        decodeSleep(instruction, decoded);
+    }
+    else if (instruction.find("READ(") == 0) {
+        decoded.op = OpCode::READ;
+        decodeMemory(instruction, decoded);
+    }
+    else if (instruction.find("WRITE(") == 0) {
+        decoded.op = OpCode::WRITE;
+        decodeMemory(instruction, decoded);
+    }
+
+    return decoded;
+}
+
+void InstructionDecoder::decodePrint(const std::string& instruction, DecodedInstruction& decoded) {
+    size_t start = instruction.find('(') + 1;
+    size_t end = instruction.find(')', start);
+    if (end == std::string::npos) {
+        return;
+    }
+
+    decoded.op = OpCode::PRINT;
+    decoded.aux = static_cast<uint32_t>(program.printSegments.size());
+
+    // Split by '+' into literal and variable segments
+    std::stringstream ss(instruction.substr(start, end - start));
+    std::string segment;
+    while (std::getline(ss, segment, '+')) {
+        segment = trim(segment);
+        if (segment.empty()) {
+            continue;
+        }
+
+        PrintSegment printSegment;
+        if (segment.front() == '"' && segment.back() == '"') {
+            printSegment.isLiteral = true;
+            printSegment.index = static_cast<uint32_t>(program.literals.size());
+            program.literals.push_back(segment.size() >= 2 ? segment.substr(1, segment.size() - 2) : "");
+        } else {
+            printSegment.index = internSymbol(segment);
+        }
+        program.printSegments.push_back(printSegment);
+        decoded.auxCount++;
+    }
+}
+
+void InstructionDecoder::decodeDeclare(const std::string& instruction, DecodedInstruction& decoded) {
+    // DECLARE(var, value)
+    std::string params = getArgumentString(instruction);
+    size_t commaPos = params.find(',');
+    if (commaPos == std::string::npos) {
+        return;
+    }
+
+    std::string varName = trim(params.substr(0, commaPos));
+    std::string valueStr = trim(params.substr(commaPos + 1));
+
+    decoded.op = OpCode::DECLARE;
+    decoded.args[0] = decodeVariableOperand(varName);
+    decoded.args[1].kind = OperandKind::IMMEDIATE;
+    try {
+        decoded.args[1].value = static_cast<uint16_t>(std::stoi(valueStr));
+    } catch (...) {
+        // Invalid value, declare as 0
+        decoded.args[1].value = 0;
+    }
+}
+
+void InstructionDecoder::decodeArithmetic(const std::string& instruction, DecodedInstruction& decoded) {
+    // ADD/SUBTRACT(target, source1, source2)
+    std::vector<std::string> args = splitArgs(getArgumentString(instruction));
+    if (args.size() < 3) {
+        decoded.op = OpCode::NOP;
+        return;
+    }
+
+    decoded.args[0] = decodeVariableOperand(args[0]);
+    decoded.args[1] = decodeValueOperand(args[1]);
+    decoded.args[2] = decodeValueOperand(args[2]);
+}
+
+void InstructionDecoder::decodeSleep(const std::string& instruction, DecodedInstruction& decoded) {
+    try {
+        int ticks = std::stoi(getArgumentString(instruction));
+        if (ticks > 0) {
+            decoded.op = OpCode::SLEEP;
+            decoded.aux = static_cast<uint32_t>(ticks);
+        }
+    } catch (...) {
+        // Invalid ticks, leave as no-op
+    }
+}
+
+void InstructionDecoder::decodeMemory(const std::string& instruction, DecodedInstruction& decoded) {
+    std::vector<std::string> args = splitArgs(getArgumentString(instruction));
+
+    // Empty arguments are dropped, as READ(, 0x10) is not a valid instruction
+    args.erase(std::remove(args.begin(), args.end(), std::string()), args.end());
+    if (args.size() < 2) {
+        decoded.op = OpCode::NOP;
+        return;
+    }
+
+    if (decoded.op == OpCode::READ) {
+        // READ(var, address)
+        decoded.args[0] = decodeVariableOperand(args[0]);
+        if (!parseAddress(args[1], decoded.aux)) {
+            decoded.op = OpCode::NOP;
+        }
+    } else {
+        // WRITE(address, value)
+        decoded.args[1] = decodeValueOperand(args[1]);
+        if (!parseAddress(args[0], decoded.aux)) {
+            decoded.op = OpCode::NOP;
+        }
+    }
+}
+
+Operand InstructionDecoder::decodeValueOperand(const std::string& arg) {
+    // Numbers are immediates, anything else names a variable
+    if (std::all_of(arg.begin(), arg.end(), ::isdigit)) {
+        Operand operand;
+        operand.kind = OperandKind::IMMEDIATE;
+        try {
+            int value = std::stoi(arg);
+            operand.value = (value < 0) ? 0 : (value > 65535) ? 65535 : static_cast<uint16_t>(value);
+        } catch (...) {
+            operand.value = 0;
+        }
+        return operand;
+    }
+
+    return decodeVariableOperand(arg);
+}
+
+Operand InstructionDecoder::decodeVariableOperand(const std::string& name) {
+    Operand operand;
+    operand.kind = OperandKind::VARIABLE;
+    operand.value = internSymbol(name);
+    return operand;
+}
+
+uint16_t InstructionDecoder::internSymbol(const std::string& name) {
+    auto it = symbolIndex.find(name);
+    if (it != symbolIndex.end()) {
+        return it->second;
+    }
+
+    if (program.symbols.size() >= SYMBOL_TABLE_SLOTS) {
+        return NO_SYMBOL;
+    }
+
+    uint16_t index = static_cast<uint16_t>(program.symbols.size());
+    program.symbols.push_back(name);
+    symbolIndex[name] = index;
+    return index;
+}
+
+std::string InstructionDecoder::getArgumentString(const std::string& instruction) {
+    size_t start = instruction.find('(') + 1;
+    size_t end = instruction.find(')', start);
+    if (end == std::string::npos) {
+        return "";
+    }
+    return instruction.substr(start, end - start);
+}
+
+std::vector<std::string> InstructionDecoder::splitArgs(const std::string& params) {
+    std::vector<std::string> args;
+
+    size_t pos = 0;
+    while (pos < params.length()) {
+        size_t commaPos = params.find(',', pos);
+        if (commaPos == std::string::npos) {
+            args.push_back(trim(params.substr(pos)));
+            break;
+        }
+        args.push_back(trim(params.substr(pos, commaPos - pos)));
+        pos = commaPos + 1;
+    }
+
+    return args;
+}
+
+std::vector<std::string> InstructionDecoder::splitTopLevel(const std::string& text, char delimiter) {
+    // Split on delimiters outside of parentheses and string literals
+    std::vector<std::string> parts;
+    std::string current;
+    int depth = 0;
+    bool inLiteral = false;
+
+    for (char c : text) {
+        if (c == '"') {
+            inLiteral = !inLiteral;
+        } else if (!inLiteral && c == '(') {
+            depth++;
+        } else if (!inLiteral && c == ')') {
+            depth--;
+        } else if (!inLiteral && depth == 0 && c == delimiter) {
+            parts.push_back(current);
+            current.clear();
+            continue;
+        }
+        current += c;
+    }
+    parts.push_back(current);
+
+    return parts;
+}
+
+std::string InstructionDecoder::trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+bool InstructionDecoder::parseAddress(const std::string& addressStr, uint32_t& address) {
+    std::string trimmed = trim(addressStr);
+
+    try {
+        // Handle hex prefix, assume decimal otherwise
+        if (trimmed.find("0x") == 0 || trimmed.find("0X") == 0) {
+            address = static_cast<uint32_t>(std::stoul(trimmed, nullptr, 16));
+        } else {
+            address = static_cast<uint32_t>(std::stoul(trimmed, nullptr, 10));
+        }
+    } catch (...) {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,96 @@
+#ifndef INSTRUCTIONDECODER_H
+#define INSTRUCTIONDECODER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Opcodes of the pre-decoded instruction stream executed by the Scheduler
+enum class OpCode : uint8_t {
+    NOP,        // Unrecognized or malformed instruction, skipped on execution
+    PRINT,
+    DECLARE,
+    ADD,
+    SUBTRACT,
+    SLEEP,
+    FOR_BEGIN,  // Loop control, resolved by Process::advanceInstruction and never dispatched
+    FOR_END,
+    READ,
+    WRITE
+};
+
+// FOR loops nest at most this deep; deeper loops decode to a NOP
+constexpr int MAX_LOOP_DEPTH = 3;
+
+// A process symbol table is 64 bytes of uint16 values (VirtualMemoryManager::SYMBOL_TABLE_SIZE),
+// so at most 32 variables get a slot; names past that decode to NO_SYMBOL and are ignored
+constexpr int SYMBOL_TABLE_SLOTS = 32;
+constexpr uint16_t NO_SYMBOL = 0xFFFF;
+
+enum class OperandKind : uint8_t {
+    NONE,
+    IMMEDIATE,  // value is a literal uint16
+    VARIABLE    // value is a symbol table slot, or NO_SYMBOL if the table was full
+};
+
+struct Operand {
+    OperandKind kind = OperandKind::NONE;
+    uint16_t value = 0;
+};
+
+// One piece of a PRINT argument list, either a string literal or a variable
+struct PrintSegment {
+    bool isLiteral = false;
+    uint32_t index = 0;     // Index into literals (isLiteral) or symbol table slot
+};
+
+struct DecodedInstruction {
+    OpCode op = OpCode::NOP;
+    Operand args[3];
+    uint32_t aux = 0;       // SLEEP ticks, READ/WRITE address, first PRINT segment, FOR_BEGIN iterations,
+                            // or FOR_END jump target (first op of the loop body)
+    uint32_t auxCount = 0;  // Number of PRINT segments
+};
+
+// Compact form of a process's instruction list, built once when instructions are set.
+// FOR bodies are compiled inline between FOR_BEGIN and FOR_END ops.
+struct DecodedProgram {
+    std::vector<DecodedInstruction> code;
+    std::vector<PrintSegment> printSegments;
+    std::vector<std::string> literals;
+    std::vector<std::string> symbols;   // Variable name of each symbol table slot
+    std::vector<std::string> listing;   // Text of each op in code, for screen/log display
+    uint64_t unrolledLength = 0;        // Instructions executed with every loop expanded
+};
+
+class InstructionDecoder {
+private:
+    DecodedProgram program;
+    std::unordered_map<std::string, uint16_t> symbolIndex;
+
+    uint64_t decodeStatement(const std::string& instruction, int loopDepth);
+    uint64_t decodeFor(const std::string& instruction, int loopDepth);
+    DecodedInstruction decodeInstruction(const std::string& instruction);
+    void decodePrint(const std::string& instruction, DecodedInstruction& decoded);
+    void decodeDeclare(const std::string& instruction, DecodedInstruction& decoded);
+    void decodeArithmetic(const std::string& instruction, DecodedInstruction& decoded);
+    void decodeSleep(const std::string& instruction, DecodedInstruction& decoded);
+    void decodeMemory(const std::string& instruction, DecodedInstruction& decoded);
+
+    Operand decodeValueOperand(const std::string& arg);
+    Operand decodeVariableOperand(const std::string& name);
+    uint16_t internSymbol(const std::string& name);
+
+    static std::string getArgumentString(const std::string& instruction);
+    static std::vector<std::string> splitArgs(const std::string& params);
+    static std::vector<std::string> splitTopLevel(const std::string& text, char delimiter);
+    static std::string trim(const std::string& str);
+    static bool parseAddress(const std::string& addressStr, uint32_t& address);
+
+public:
+    // Decode a full instruction list; text is preserved in the listing
+    DecodedProgram decode(const std::vector<std::string>& instructions);
+};
+
+#endif
@@ -2,16 +2,20 @@
 #include <sstream>
 #include <algorithm>
 #include <ctime>
+#include <iomanip>
 
-InstructionGenerator::InstructionGenerator() : rng(std::time(nullptr)), variableCounter(0) {
+InstructionGenerator::InstructionGenerator() : rng(std::time(nullptr)), variableCounter(0), memoryLimit(0) {
 }
 
 std::vector<std::string> InstructionGenerator::generateRandomInstructions(
     const std::string& processName,
     int minInstructions, 
-    int maxInstructions
+    int maxInstructions,
+    size_t memorySize
 ) {
     resetVariableCounter();
+    // A word is two bytes, so smaller spaces have nothing to address
+    memoryLimit = memorySize >= 2 ? memorySize : 0;
 
     std::uniform_int_distribution<int> countDist(minInstructions, maxInstructions);
     int instructionCount = countDist(rng);
@@ -30,9 +34,14 @@ std::string InstructionGenerator::generateRandomInstruction(
     const std::string& processName,
     bool allowNestedInstructions
 ) {
-    // Instruction types: PRINT, DECLARE, ADD, SUBTRACT, SLEEP, FOR
-    std::uniform_int_distribution<int> typeDist(0, allowNestedInstructions ? 5 : 3);
+    // Instruction types: PRINT, DECLARE, ADD, SUBTRACT, SLEEP, FOR, then READ and WRITE
+    // when the process has memory to address
+    int baseTypes = allowNestedInstructions ? 6 : 4;
+    std::uniform_int_distribution<int> typeDist(0, baseTypes + (memoryLimit > 0 ? 1 : -1));
     int instructionType = typeDist(rng);
+    if (instructionType >= baseTypes) {
+        return instructionType == baseTypes ? generateReadInstruction() : generateWriteInstruction();
+    }
     
     switch (instructionType) {
         case 0: return generatePrintInstruction(processName);
@@ -114,12 +123,28 @@ std::string InstructionGenerator::generateForInstruction(int nestingLevel) {
     return "FOR(" + instructionBlock + ", " + std::to_string(loopCount) + ")";
 }
 
+std::string InstructionGenerator::generateReadInstruction() {
+    return "READ(" + getNextVariableName() + ", " + getRandomAddress() + ")";
+}
+
+std::string InstructionGenerator::generateWriteInstruction() {
+    return "WRITE(" + getRandomAddress() + ", " + std::to_string(getRandomUint16()) + ")";
+}
+
+std::string InstructionGenerator::getRandomAddress() {
+    // Word-aligned and inside the process, so generated programs never fault on access
+    std::uniform_int_distribution<size_t> wordDist(0, memoryLimit / 2 - 1);
+    std::stringstream ss;
+    ss << "0x" << std::hex << wordDist(rng) * 2;
+    return ss.str();
+}
+
 std::vector<std::string> InstructionGenerator::generateNestedInstructions(int count) {
     std::vector<std::string> instructions;
     instructions.reserve(count);
     
     for (int i = 0; i < count; ++i) {
-        // Only allow PRINT, DECLARE, ADD, SUBTRACT in nested blocks (no FOR or SLEEP)
+        // Only allow PRINT, DECLARE, ADD, SUBTRACT, READ, WRITE in nested blocks (no FOR or SLEEP)
         instructions.push_back(generateRandomInstruction("nested", false));
     }
     
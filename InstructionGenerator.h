@@ -9,6 +9,7 @@ class InstructionGenerator {
 private:
     std::mt19937 rng;
     int variableCounter;
+    size_t memoryLimit;     // Bytes READ and WRITE may address, 0 to leave them out
     
     std::string generatePrintInstruction(const std::string& processName);
     std::string generateDeclareInstruction();
@@ -16,6 +17,9 @@ private:
     std::string generateSubtractInstruction();
     std::string generateSleepInstruction();
     std::string generateForInstruction(int nestingLevel = 0);
+    std::string generateReadInstruction();
+    std::string generateWriteInstruction();
+    std::string getRandomAddress();
     
     std::vector<std::string> generateNestedInstructions(int count);
     
@@ -28,11 +32,13 @@ private:
 public:
     InstructionGenerator();
     
-    // Main method to generate a complete instruction sequence
+    // Main method to generate a complete instruction sequence. With a
+    // memorySize, READ and WRITE within that many bytes join the mix.
     std::vector<std::string> generateRandomInstructions(
         const std::string& processName,
         int minInstructions, 
-        int maxInstructions
+        int maxInstructions,
+        size_t memorySize = 0
     );
     
     // Generate a single random instruction
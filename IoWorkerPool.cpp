@@ -0,0 +1,65 @@
+#include "IoWorkerPool.h"
+#include <iostream>
+
+IoWorkerPool::IoWorkerPool() : stopping(false), outstanding(0) {}
+
+IoWorkerPool::~IoWorkerPool() {
+    stop();
+}
+
+void IoWorkerPool::start(int threadCount) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!workers.empty()) {
+        return;
+    }
+    stopping = false;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&IoWorkerPool::workerLoop, this);
+    }
+}
+
+void IoWorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+void IoWorkerPool::submit(std::function<void()> job) {
+    outstanding++;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        jobs.push_back(std::move(job));
+    }
+    jobReady.notify_one();
+}
+
+void IoWorkerPool::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            // Drain before exiting so no submitted job is lost
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            std::cerr << "Exception in I/O worker: " << e.what() << std::endl;
+        }
+        outstanding--;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef IOWORKERPOOL_H
+#define IOWORKERPOOL_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+// Small fixed pool of threads for blocking work the CPU cores must not wait on,
+// such as reading a faulted page from the backing store. Jobs run in FIFO order.
+class IoWorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex poolMutex;
+    std::condition_variable jobReady;
+    bool stopping;
+    std::atomic<size_t> outstanding;    // Queued plus running jobs
+
+    void workerLoop();
+
+public:
+    IoWorkerPool();
+    ~IoWorkerPool();
+
+    // Spawn threadCount workers; no-op while already running
+    void start(int threadCount);
+
+    // Finish every queued job, then join the workers
+    void stop();
+
+    void submit(std::function<void()> job);
+    size_t pending() const { return outstanding; }
+};
+
+#endif
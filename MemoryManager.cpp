@@ -6,8 +6,8 @@
 #include <cmath>
 
 MemoryManager::MemoryManager(int totalMem, int memPerProc, int memPerFrame, const std::string& policy)
-    : totalMemory(totalMem), memoryPerProcess(memPerProc), memoryPerFrame(memPerFrame), 
-      fitPolicy(policy), currentQuantum(0) {
+    : totalMemory(totalMem), memoryPerProcess(memPerProc), allocatedMemory(0), memoryPerFrame(memPerFrame), 
+      fitPolicy(policy), nextFitAddress(0), currentQuantum(0) {
     initialize();
 }
 
@@ -30,15 +30,40 @@ void MemoryManager::initialize() {
     }
     
     try {
-        memoryBlocks.clear();
-        // Start with one large free block representing all available memory
-        memoryBlocks.emplace_back(0, totalMemory);
+        allocatedBlocks.clear();
+        processBlocks.clear();
+        freeHoles.clear();
+        nextFitAddress = 0;
+        allocatedMemory = 0;
+        if (usesBuddy()) {
+            // Frames are the smallest unit the buddy allocator hands out
+            buddy.reset(totalMemory, memoryPerFrame);
+        } else {
+            // Start with one large free block representing all available memory
+            freeHoles.insert(0, totalMemory);
+        }
         // Removed verbose initialization log
     } catch (const std::exception& e) {
         std::cerr << "Exception in initialize: " << e.what() << std::endl;
     }
 }
 
+int MemoryManager::findHole(int size) {
+    // Called with memoryMutex held
+    if (fitPolicy == "B") {
+        return freeHoles.bestFit(size);
+    }
+    if (fitPolicy == "W") {
+        return freeHoles.worstFit(size);
+    }
+    if (fitPolicy == "N") {
+        // Resume after the last placement, wrapping around to the start once
+        int address = freeHoles.firstFit(size, nextFitAddress);
+        return (address != -1) ? address : freeHoles.firstFit(size, 0);
+    }
+    return freeHoles.firstFit(size, 0);
+}
+
 bool MemoryManager::allocateMemory(std::shared_ptr<Process> process) {
     if (!process) {
         std::cerr << "Error: Null process passed to allocateMemory" << std::endl;
@@ -60,87 +85,41 @@ bool MemoryManager::allocateMemory(std::shared_ptr<Process> process) {
     try {
         std::lock_guard<std::mutex> lock(memoryMutex);
         
-        // Removed debug output about memory allocation attempt
-        
-        // Safety check for empty vector
-        if (memoryBlocks.empty()) {
-            // Initialize with a default block if empty
-            try {
-                memoryBlocks.emplace_back(0, totalMemory);
-            } catch (const std::exception& e) {
-                std::cerr << "Exception during memory initialization: " << e.what() << std::endl;
-                return false;
-            }
+        int requiredSize = process->getMemorySize() > 0 ? process->getMemorySize() : memoryPerProcess;
+        int processId = process->getProcessId();
+        if (requiredSize > totalMemory) {
+            return false;
         }
         
-        // Debug block logging removed for less verbosity
-        // Only log in case of errors
+        // A process holds at most one block
+        if (processBlocks.count(processId)) {
+            return true;
+        }
         
-        int requiredSize = memoryPerProcess;
-        int processId = process->getProcessId();
-        std::string processName = process->getName();
+        int address = usesBuddy() ? buddy.allocate(requiredSize) : findHole(requiredSize);
+        if (address == -1) {
+            // No suitable block found
+            return false;
+        }
         
-        // First-fit algorithm: find the first free block that's big enough
-        for (auto& block : memoryBlocks) {
-            if (block.isFree && block.size >= requiredSize) {
-                // Found a block that can fit the process
-                
-                if (block.size == requiredSize) {
-                    // Perfect fit - just mark the block as allocated
-                    block.isFree = false;
-                    block.processName = processName;
-                    block.processId = processId;
-                } else {
-                    // Split the block
-                    int remainingSize = block.size - requiredSize;
-                    block.size = requiredSize;
-                    block.isFree = false;
-                    block.processName = processName;
-                    block.processId = processId;
-                    
-                    // Create a new block for the remaining space
-                    MemoryBlock newBlock(block.startAddress + requiredSize, remainingSize);
-                    
-                    // Make sure we don't exceed vector capacity
-                    if (memoryBlocks.size() >= memoryBlocks.max_size() - 1) {
-                        std::cerr << "Warning: Vector capacity limit reached, not splitting block" << std::endl;
-                        // Can't add more blocks, just mark the whole block as used
-                        return true;
-                    }
-                    
-                    // Find the index of the current block to avoid iterator invalidation
-                    size_t blockIndex = 0;
-                    for (size_t i = 0; i < memoryBlocks.size(); ++i) {
-                        if (memoryBlocks[i].startAddress == block.startAddress) {
-                            blockIndex = i;
-                            break;
-                        }
-                    }
-                    
-                    // Insert the new block after the current one using the index
-                    // Fix: blockIndex + 1 <= memoryBlocks.size() should be <= not <
-                    if (blockIndex + 1 < memoryBlocks.size()) {
-                        try {
-                            memoryBlocks.insert(memoryBlocks.begin() + blockIndex + 1, newBlock);
-                        } catch (const std::exception& e) {
-                            std::cerr << "Exception while inserting new block: " << e.what() << std::endl;
-                        }
-                    } else {
-                        // Push back if it's at the end
-                        try {
-                            memoryBlocks.push_back(newBlock);
-                        } catch (const std::exception& e) {
-                            std::cerr << "Exception while pushing back new block: " << e.what() << std::endl;
-                        }
-                    }
-                }
-                return true;
+        if (!usesBuddy()) {
+            // Carve the block from the front of the hole and keep the remainder free
+            int holeSize = freeHoles.sizeAt(address);
+            freeHoles.erase(address);
+            if (holeSize > requiredSize) {
+                freeHoles.insert(address + requiredSize, holeSize - requiredSize);
             }
         }
         
-        // No suitable block found
-        // std::cout << "No suitable free block found for process " << process->getName() << std::endl;
-        return false;
+        MemoryBlock block(address, requiredSize);
+        block.isFree = false;
+        block.processName = process->getName();
+        block.processId = processId;
+        allocatedBlocks.emplace(address, block);
+        processBlocks[processId] = address;
+        nextFitAddress = address + requiredSize;
+        allocatedMemory += requiredSize;
+        return true;
     } catch (const std::exception& e) {
         std::cerr << "Exception in allocateMemory: " << e.what() << std::endl;
         return false;
@@ -157,42 +136,39 @@ void MemoryManager::deallocateMemory(int processId) {
     try {
         std::lock_guard<std::mutex> lock(memoryMutex);
         
-        // Safety check for empty vector
-        if (memoryBlocks.empty()) {
+        auto owner = processBlocks.find(processId);
+        if (owner == processBlocks.end()) {
             return;
         }
         
-        // Find all blocks allocated to this process and free them
-        int blocksFreed = 0;
-        for (auto& block : memoryBlocks) {
-            if (!block.isFree && block.processId == processId) {
-                block.isFree = true;
-                block.processName = "";
-                block.processId = -1;
-                blocksFreed++;
-            }
-        }
+        auto blockIt = allocatedBlocks.find(owner->second);
+        int start = blockIt->second.startAddress;
+        int size = blockIt->second.size;
+        allocatedBlocks.erase(blockIt);
+        processBlocks.erase(owner);
+        allocatedMemory -= size;
         
-        // Removed verbose logging for memory deallocation
+        if (usesBuddy()) {
+            buddy.release(start);
+            return;
+        }
         
-        // Merge adjacent free blocks - safer implementation
-        if (memoryBlocks.size() > 1) { // Only attempt to merge if there's more than one block
-            bool merged;
-            do {
-                merged = false;
-                // Use indices instead of iterators to avoid iterator invalidation issues
-                for (size_t i = 0; i < memoryBlocks.size() - 1; ++i) {
-                    if (memoryBlocks[i].isFree && memoryBlocks[i+1].isFree) {
-                        // Merge the blocks
-                        memoryBlocks[i].size += memoryBlocks[i+1].size;
-                        // Remove the next block
-                        memoryBlocks.erase(memoryBlocks.begin() + i + 1);
-                        merged = true;
-                        break; // Start over to avoid index invalidation
-                    }
-                }
-            } while (merged && memoryBlocks.size() > 1);
+        // Coalesce with the free neighbours on either side
+        int nextSize = freeHoles.sizeAt(start + size);
+        if (nextSize > 0) {
+            freeHoles.erase(start + size);
+            size += nextSize;
+        }
+        int previous = freeHoles.predecessor(start);
+        if (previous != -1) {
+            int previousSize = freeHoles.sizeAt(previous);
+            if (previous + previousSize == start) {
+                freeHoles.erase(previous);
+                start = previous;
+                size += previousSize;
+            }
         }
+        freeHoles.insert(start, size);
     } catch (const std::exception& e) {
         std::cerr << "Exception in deallocateMemory: " << e.what() << std::endl;
     }
@@ -209,60 +185,41 @@ bool MemoryManager::hasAvailableMemory(int size) const {
         return false;
     }
     
-    try {
-        std::lock_guard<std::mutex> lock(memoryMutex);
-        
-        // Safety check for empty vector
-        if (memoryBlocks.empty()) {
-            // If the vector is empty, initialize it
-            const_cast<MemoryManager*>(this)->initialize();
-        }
-        
-        // Check if any free block is large enough
-        for (const auto& block : memoryBlocks) {
-            if (block.isFree && block.size >= size) {
-                return true;
-            }
-        }
-        
-        return false;
-    } catch (const std::exception& e) {
-        std::cerr << "Exception in hasAvailableMemory: " << e.what() << std::endl;
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    return usesBuddy() ? buddy.canAllocate(size) : freeHoles.largest() >= size;
 }
 
 int MemoryManager::calculateExternalFragmentation() const {
     std::lock_guard<std::mutex> lock(memoryMutex);
     
-    int totalFreeMemory = 0;
-    int largestFreeBlock = 0;
-    
-    for (const auto& block : memoryBlocks) {
-        if (block.isFree) {
-            totalFreeMemory += block.size;
-            largestFreeBlock = std::max(largestFreeBlock, block.size);
-        }
-    }
-    
     // External fragmentation is the memory that can't be used for process allocation
-    // because it's scattered in small fragments
-    if (totalFreeMemory < memoryPerProcess) {
-        // All free memory is external fragmentation if it can't hold a process
-        return totalFreeMemory;
-    }
-    
-    // Calculate total unusable memory (fragments smaller than memoryPerProcess)
+    // because it's scattered in small fragments. Holes are walked smallest first,
+    // so only the fragments themselves are visited.
     int unusableMemory = 0;
-    for (const auto& block : memoryBlocks) {
-        if (block.isFree && block.size < memoryPerProcess) {
-            unusableMemory += block.size;
+    if (usesBuddy()) {
+        buddy.forEachFree([&](int address, int size) {
+            if (size < memoryPerProcess) {
+                unusableMemory += size;
+            }
+        });
+        return unusableMemory;
+    }
+    for (const auto& [size, address] : freeHoles.holesBySize()) {
+        if (size >= memoryPerProcess) {
+            break;
         }
+        unusableMemory += size;
     }
     
     return unusableMemory;
 }
 
+int MemoryManager::calculateInternalFragmentation() const {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    // Hole-fit policies carve exact sizes, so only buddy rounding wastes space
+    return usesBuddy() ? buddy.getInternalFragmentation() : 0;
+}
+
 void MemoryManager::generateMemorySnapshot(int quantumCycle) {
     currentQuantum = quantumCycle;
     
@@ -286,6 +243,9 @@ void MemoryManager::generateMemorySnapshot(int quantumCycle) {
     
     int externalFrag = calculateExternalFragmentation();
     file << "Total external fragmentation in KB: " << externalFrag / 1024 << std::endl;
+    if (usesBuddy()) {
+        file << "Total internal fragmentation in KB: " << calculateInternalFragmentation() / 1024 << std::endl;
+    }
     
     // Add ASCII memory representation
     file << std::endl << generateASCIIPrintout() << std::endl;
@@ -295,20 +255,12 @@ void MemoryManager::generateMemorySnapshot(int quantumCycle) {
 
 int MemoryManager::getProcessesInMemory() const {
     std::lock_guard<std::mutex> lock(memoryMutex);
-    
-    if (memoryBlocks.empty()) {
-        return 0;
-    }
-    
-    // Count unique process IDs in allocated blocks
-    std::set<int> uniqueProcessIds;
-    for (const auto& block : memoryBlocks) {
-        if (!block.isFree && block.processId >= 0) {
-            uniqueProcessIds.insert(block.processId);
-        }
-    }
-    
-    return uniqueProcessIds.size();
+    return static_cast<int>(processBlocks.size());
+}
+
+int MemoryManager::getAllocatedMemory() const {
+    std::lock_guard<std::mutex> lock(memoryMutex);
+    return allocatedMemory;
 }
 
 void MemoryManager::setCurrentQuantum(int quantum) {
@@ -322,50 +274,20 @@ std::string MemoryManager::getMemoryASCIIRepresentation() const {
 std::pair<int, int> MemoryManager::getProcessMemoryMap(int processId) const {
     std::lock_guard<std::mutex> lock(memoryMutex);
     
-    int startAddress = -1;
-    int endAddress = -1;
-    
     // Safety check for valid processId
     if (processId < 0) {
         std::cout << "Warning: Invalid process ID in getProcessMemoryMap: " << processId << std::endl;
         return {-1, -1};
     }
     
-    // Safety check for empty vector
-    if (memoryBlocks.empty()) {
-        std::cout << "Warning: Memory blocks vector is empty in getProcessMemoryMap" << std::endl;
+    auto owner = processBlocks.find(processId);
+    if (owner == processBlocks.end()) {
+        std::cout << "Warning: No memory blocks found for process ID: " << processId << std::endl;
         return {-1, -1};
     }
     
-    try {
-        for (const auto& block : memoryBlocks) {
-            if (!block.isFree && block.processId == processId) {
-                // Found a block allocated to this process
-                if (startAddress == -1 || block.startAddress < startAddress) {
-                    startAddress = block.startAddress;
-                }
-                
-                int blockEnd = block.startAddress + block.size;
-                if (blockEnd > endAddress) {
-                    endAddress = blockEnd;
-                }
-            }
-        }
-        
-        if (startAddress == -1 || endAddress == -1) {
-            std::cout << "Warning: No memory blocks found for process ID: " << processId << std::endl;
-        } 
-        // else 
-        // {
-        //     std::cout << "Memory map for process ID " << processId 
-        //               << ": start=" << startAddress << ", end=" << endAddress << std::endl;
-        // }
-    } catch (const std::exception& e) {
-        std::cerr << "Exception in getProcessMemoryMap: " << e.what() << std::endl;
-        return {-1, -1};
-    }
-    
-    return {startAddress, endAddress};
+    const MemoryBlock& block = allocatedBlocks.at(owner->second);
+    return {block.startAddress, block.startAddress + block.size};
 }
 
 std::string MemoryManager::generateASCIIPrintout() const {
@@ -376,54 +298,13 @@ std::string MemoryManager::generateASCIIPrintout() const {
         // Memory end marker
         ss << "----end---- = " << totalMemory << std::endl << std::endl;
         
-        // Check if we have any memory blocks
-        if (memoryBlocks.empty()) {
-            // If no blocks, just print start marker
-            ss << "----start---- = 0" << std::endl;
-            return ss.str();
-        }
-        
-        // Create a copy of memory blocks for safety
-    std::vector<MemoryBlock> sortedBlocks;
-    try {
-        sortedBlocks = memoryBlocks; // Make a copy
-        
-        // Sort blocks by address in descending order for top-down visualization
-        std::sort(sortedBlocks.begin(), sortedBlocks.end(), 
-              [](const MemoryBlock& a, const MemoryBlock& b) {
-                  return a.startAddress > b.startAddress;
-              });
-    } catch (const std::exception& e) {
-        // If any exception occurs, return a basic representation
-        ss << "Error generating memory printout: " << e.what() << std::endl;
-        ss << "----start---- = 0" << std::endl;
-        return ss.str();
-    }        // Visualize memory from top (high address) to bottom (low address)
-        int currentAddress = totalMemory;
-        
-        for (const auto& block : sortedBlocks) {
-            // Safe bounds checking
-            if (block.startAddress < 0 || block.startAddress >= totalMemory ||
-                block.size <= 0 || block.startAddress + block.size > totalMemory) {
-                ss << "Warning: Invalid block (address=" << block.startAddress 
-                   << ", size=" << block.size << ")" << std::endl;
-                continue;
-            }
-            
-            // Fill any gap between blocks
-            if (block.startAddress + block.size < currentAddress) {
-                ss << currentAddress << std::endl;
-                currentAddress = block.startAddress + block.size;
-            }
-            
-            if (!block.isFree) {
-                // Show allocated block
-                ss << currentAddress << std::endl;
-                ss << (block.processName.empty() ? "unnamed" : block.processName) << std::endl;
-                ss << block.startAddress << std::endl << std::endl;
-            }
-            
-            currentAddress = block.startAddress;
+        // Visualize allocated blocks from top (high address) to bottom (low address);
+        // free holes between them are skipped silently
+        for (auto it = allocatedBlocks.rbegin(); it != allocatedBlocks.rend(); ++it) {
+            const MemoryBlock& block = it->second;
+            ss << (block.startAddress + block.size) << std::endl;
+            ss << (block.processName.empty() ? "unnamed" : block.processName) << std::endl;
+            ss << block.startAddress << std::endl << std::endl;
         }
         
         // Memory start marker
@@ -7,10 +7,13 @@
 #include <mutex>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <chrono>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include "HoleIndex.h"
+#include "BuddyAllocator.h"
 
 class Process;
 
@@ -33,13 +36,23 @@ inline bool operator==(const MemoryBlock& a, const MemoryBlock& b) {
 
 class MemoryManager {
 private:
-    std::vector<MemoryBlock> memoryBlocks;
+    HoleIndex freeHoles;                            // Free space, indexed by address and by size
+    BuddyAllocator buddy;                           // Free space when hole-fit-policy is buddy
+    std::map<int, MemoryBlock> allocatedBlocks;     // Allocated blocks by start address
+    std::unordered_map<int, int> processBlocks;     // processId -> start address of its block
     int totalMemory;        // Total available memory (16384 bytes)
-    int memoryPerProcess;   // Fixed memory per process (4096 bytes)
+    int memoryPerProcess;   // Default memory per process (4096 bytes)
+    int allocatedMemory;    // Bytes held by processes, as requested
     int memoryPerFrame;     // Memory per frame (16 bytes)
-    std::string fitPolicy;  // F for First-fit
+    std::string fitPolicy;  // F First-fit, N Next-fit, B Best-fit, W Worst-fit, buddy
+    int nextFitAddress;     // Where the next-fit search resumes
     mutable std::mutex memoryMutex; // For thread-safe operations
     int currentQuantum;     // Current quantum cycle
+    
+    // Pick a hole for size bytes under the configured policy, -1 if none fits
+    int findHole(int size);
+
+    bool usesBuddy() const { return fitPolicy == "buddy"; }
 
 public:
     MemoryManager(int totalMem = 16384, int memPerProc = 4096, int memPerFrame = 16, const std::string& policy = "F");
@@ -48,7 +61,8 @@ public:
     // Initialize memory with a single free block
     void initialize();
 
-    // First-fit memory allocation
+    // Allocate the process's memory size, or the default when it has none,
+    // using the configured hole-fit policy
     bool allocateMemory(std::shared_ptr<Process> process);
 
     // Memory deallocation
@@ -60,12 +74,18 @@ public:
     // Calculate external fragmentation
     int calculateExternalFragmentation() const;
 
+    // Bytes lost to rounding requests up to buddy block sizes (0 for hole-fit policies)
+    int calculateInternalFragmentation() const;
+
     // Generate memory snapshot for the current quantum cycle
     void generateMemorySnapshot(int quantumCycle);
 
     // Get number of processes in memory
     int getProcessesInMemory() const;
 
+    // Bytes currently allocated to processes
+    int getAllocatedMemory() const;
+
     // Set the current quantum cycle
     void setCurrentQuantum(int quantum);
 
@@ -9,7 +9,9 @@ Process::Process(const std::string& name, int id, int totalCommands)
       isActive(true), assignedCore(-1), startTime(std::chrono::steady_clock::now()),
       hasMemoryAllocated(false), memorySize(0), memoryStartAddress(-1), memoryEndAddress(-1),
       virtualMemorySize(0), virtualBaseAddress(0),
-      currentInstructionIndex(0), isExecutingAutomatically(false) {
+      currentInstructionIndex(0), programCounter(0), isExecutingAutomatically(false),
+      variableSlots{}, declaredSlots(0), state(ProcessState::READY), sleepTicks(0), faultAddress(0), priority(0),
+      arrivalTick(0), finishTick(0), cpuTicks(0), loopStack{}, loopDepth(0) {
     
     time_t t = time(nullptr);
     tm* now = localtime(&t);
@@ -65,53 +67,113 @@ void Process::incrementLine() {
 
 // Instruction management methods
 void Process::setInstructions(const std::vector<std::string>& instructionList) {
-    instructions = instructionList;
+    InstructionDecoder decoder;
+    program = decoder.decode(instructionList);
+    variableSlots.fill(0);
+    declaredSlots = 0;
     currentInstructionIndex = 0;
-    totalLines = static_cast<int>(instructions.size());
+    totalLines = static_cast<int>(std::min<uint64_t>(program.unrolledLength, INT32_MAX));
     isExecutingAutomatically = true;
+    
+    // Step over any loop heads so the first op is executable
+    programCounter = 0;
+    loopDepth = 0;
+    resolveLoopControl(programCounter, loopStack, loopDepth);
 }
 
 std::string Process::getCurrentInstruction() const {
-    if (currentInstructionIndex < static_cast<int>(instructions.size())) {
-        return instructions[currentInstructionIndex];
+    if (programCounter < program.listing.size()) {
+        return program.listing[programCounter];
     }
     return "";
 }
 
 bool Process::hasMoreInstructions() const {
-    return currentInstructionIndex < static_cast<int>(instructions.size());
+    return programCounter < program.code.size();
 }
 
 void Process::advanceInstruction() {
     if (hasMoreInstructions()) {
+        programCounter++;
+        resolveLoopControl(programCounter, loopStack, loopDepth);
         currentInstructionIndex++;
         currentLine = currentInstructionIndex + 1;
         
         if (!hasMoreInstructions()) {
             isActive = false;
+            state = ProcessState::FINISHED;
+        }
+    }
+}
+
+void Process::resolveLoopControl(uint32_t& pc, std::array<LoopFrame, MAX_LOOP_DEPTH>& stack, int& depth) const {
+    // Loop control ops cost no tick, so they are stepped through until pc rests on a real instruction.
+    // The decoder guarantees at most MAX_LOOP_DEPTH nesting, a non-empty body and at least one iteration.
+    while (pc < program.code.size()) {
+        const DecodedInstruction& op = program.code[pc];
+        if (op.op == OpCode::FOR_BEGIN) {
+            stack[depth++] = {op.aux, pc + 1};
+            pc++;
+        } else if (op.op == OpCode::FOR_END) {
+            LoopFrame& frame = stack[depth - 1];
+            if (--frame.remaining > 0) {
+                pc = frame.bodyStart;
+            } else {
+                depth--;
+                pc++;
+            }
+        } else {
+            break;
         }
     }
 }
 
-void Process::addToExecutionLog(const std::string& instruction) {
-    executionLog.push_back(instruction);
+void Process::sleepFor(uint32_t ticks) {
+    // The Scheduler parks the process once the SLEEP instruction has been retired
+    sleepTicks = ticks;
+    state = ProcessState::SLEEPING;
+}
+
+void Process::blockOnPageFault(uint32_t virtualAddr) {
+    // The instruction is not retired, so it runs again once the page is resident
+    faultAddress = virtualAddr;
+    state = ProcessState::BLOCKED_IO;
 }
 
 // Variable management methods
+int Process::findSymbolSlot(const std::string& name) const {
+    for (size_t i = 0; i < program.symbols.size(); ++i) {
+        if (program.symbols[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
 void Process::setVariable(const std::string& name, uint16_t value) {
-    variables[name] = value;
+    int slot = findSymbolSlot(name);
+    if (slot == -1) {
+        // Symbol table is full, so the variable is ignored
+        if (program.symbols.size() >= SYMBOL_TABLE_SLOTS) {
+            return;
+        }
+        program.symbols.push_back(name);
+        slot = static_cast<int>(program.symbols.size() - 1);
+    }
+    setSymbolValue(static_cast<uint16_t>(slot), value);
 }
 
 uint16_t Process::getVariable(const std::string& name) const {
-    auto it = variables.find(name);
-    if (it != variables.end()) {
-        return it->second;
+    int slot = findSymbolSlot(name);
+    if (slot != -1 && (declaredSlots & (1u << slot))) {
+        return variableSlots[slot];
     }
     return 0;
 }
 
 bool Process::hasVariable(const std::string& name) const {
-    return variables.find(name) != variables.end();
+    int slot = findSymbolSlot(name);
+    return slot != -1 && (declaredSlots & (1u << slot));
 }
 
 void Process::ensureVariableExists(const std::string& name) {
@@ -121,6 +183,12 @@ void Process::ensureVariableExists(const std::string& name) {
 }
 
 std::map<std::string, uint16_t> Process::getAllVariables() const {
+    std::map<std::string, uint16_t> variables;
+    for (size_t slot = 0; slot < program.symbols.size(); ++slot) {
+        if (declaredSlots & (1u << slot)) {
+            variables[program.symbols[slot]] = variableSlots[slot];
+        }
+    }
     return variables;
 }
 
@@ -171,7 +239,20 @@ int Process::getCurrentInstructionIndex() const {
 }
 
 std::vector<std::string> Process::getExecutionLog() const {
-    return executionLog;
+    // Loop counts are fixed at decode time, so the executed sequence is replayed from the start
+    std::vector<std::string> log;
+    log.reserve(currentInstructionIndex);
+    
+    uint32_t pc = 0;
+    std::array<LoopFrame, MAX_LOOP_DEPTH> stack{};
+    int depth = 0;
+    resolveLoopControl(pc, stack, depth);
+    for (int i = 0; i < currentInstructionIndex && pc < program.code.size(); ++i) {
+        log.push_back(program.listing[pc]);
+        pc++;
+        resolveLoopControl(pc, stack, depth);
+    }
+    return log;
 }
 
 // Memory management getters and setters
@@ -5,6 +5,19 @@
 #include <chrono>
 #include <vector>
 #include <map>
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include "InstructionDecoder.h"
+
+// Scheduling state, updated by the Scheduler as the process moves between cores and queues
+enum class ProcessState : uint8_t {
+    READY,
+    RUNNING,
+    SLEEPING,   // Parked in the Scheduler's timer wheel until its SLEEP ticks expire
+    BLOCKED_IO, // Waiting off-core for a page fault; the faulting instruction reruns on wake
+    FINISHED
+};
 
 class Process {
 private:
@@ -28,11 +41,34 @@ private:
     uint32_t virtualBaseAddress;
     
     // Instruction execution support
-    std::vector<std::string> instructions;
-    int currentInstructionIndex;
+    DecodedProgram program;         // Decoded once in setInstructions, text kept in program.listing
+    int currentInstructionIndex;    // Instructions executed so far, with loops unrolled
+    uint32_t programCounter;        // Next op in program.code, never a loop control op
     bool isExecutingAutomatically;
-    std::vector<std::string> executionLog;
-    std::map<std::string, uint16_t> variables;
+    std::array<uint16_t, SYMBOL_TABLE_SLOTS> variableSlots;  // Indexed by decoded symbol slot
+    uint32_t declaredSlots;                                  // Bit per slot that has been declared
+    
+    // Scheduling state
+    std::atomic<ProcessState> state;
+    uint32_t sleepTicks;            // Ticks requested by the last SLEEP instruction
+    uint32_t faultAddress;          // Virtual address of the fault that blocked the process
+    int priority;                   // Higher is admitted first under admission-policy priority
+    
+    // Tick accounting, stamped from the CPU clock
+    uint64_t arrivalTick;
+    uint64_t finishTick;
+    uint64_t cpuTicks;              // Ticks spent holding a core, including delay-per-exec
+
+    // Active FOR loops, innermost last
+    struct LoopFrame {
+        uint32_t remaining;         // Iterations left, including the current one
+        uint32_t bodyStart;         // Op to jump back to at FOR_END
+    };
+    std::array<LoopFrame, MAX_LOOP_DEPTH> loopStack;
+    int loopDepth;
+    
+    int findSymbolSlot(const std::string& name) const;
+    void resolveLoopControl(uint32_t& pc, std::array<LoopFrame, MAX_LOOP_DEPTH>& stack, int& depth) const;
 
 public:
     Process(const std::string& name, int id, int totalCommands = 100);
@@ -63,16 +99,29 @@ public:
     // Instruction management
     void setInstructions(const std::vector<std::string>& instructionList);
     std::string getCurrentInstruction() const;
+    const DecodedInstruction& getCurrentDecodedInstruction() const { return program.code[programCounter]; }
+    const DecodedProgram& getProgram() const { return program; }
     bool hasMoreInstructions() const;
     void advanceInstruction();
-    void addToExecutionLog(const std::string& instruction);
     
-    // Variable management
+    // Variable management by name (slow path, resolves the name to its slot)
     void setVariable(const std::string& name, uint16_t value);
     uint16_t getVariable(const std::string& name) const;
     bool hasVariable(const std::string& name) const;
     void ensureVariableExists(const std::string& name);
-    std::map<std::string, uint16_t> getAllVariables() const;
+    std::map<std::string, uint16_t> getAllVariables() const;  // Built on demand for display
+    
+    // Variable access by decoded symbol slot (hot path used by the Scheduler)
+    uint16_t getSymbolValue(uint16_t slot) {
+        if (slot == NO_SYMBOL) return 0;
+        declaredSlots |= (1u << slot);  // Reading an undeclared variable declares it as 0
+        return variableSlots[slot];
+    }
+    void setSymbolValue(uint16_t slot, uint16_t value) {
+        if (slot == NO_SYMBOL) return;
+        declaredSlots |= (1u << slot);
+        variableSlots[slot] = value;
+    }
     
     // Virtual memory methods for Phase 2
     void setVirtualMemorySize(size_t size);
@@ -90,6 +139,24 @@ public:
     void setAutoExecuting(bool autoExec);
     int getCurrentInstructionIndex() const;
     std::vector<std::string> getExecutionLog() const;
+    
+    // Scheduling state
+    ProcessState getState() const { return state; }
+    void setState(ProcessState newState) { state = newState; }
+    void sleepFor(uint32_t ticks);
+    uint32_t getSleepTicks() const { return sleepTicks; }
+    void blockOnPageFault(uint32_t virtualAddr);
+    uint32_t getFaultAddress() const { return faultAddress; }
+    int getPriority() const { return priority; }
+    void setPriority(int value) { priority = value; }
+    
+    // Tick accounting
+    uint64_t getArrivalTick() const { return arrivalTick; }
+    void setArrivalTick(uint64_t tick) { arrivalTick = tick; }
+    uint64_t getFinishTick() const { return finishTick; }
+    void setFinishTick(uint64_t tick) { finishTick = tick; }
+    uint64_t getCpuTicks() const { return cpuTicks; }
+    void addCpuTicks(uint64_t ticks) { cpuTicks += ticks; }
 };
 
 #endif
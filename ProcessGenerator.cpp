@@ -3,16 +3,88 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <algorithm>
 
 ProcessGenerator::ProcessGenerator(ProcessManager* pm) 
-    : generating(false), processCounter(0), processManager(pm),
-      rng(std::chrono::steady_clock::now().time_since_epoch().count()) {
+    : generating(false), tickListenerId(-1), nextGenerationTick(0), processCounter(0), minMemory(0), maxMemory(0), memoryInstructions(false), processManager(pm),
+      rng(std::chrono::steady_clock::now().time_since_epoch().count()), priorityDist(0, PRIORITY_LEVELS - 1),
+      arrivalProcess(ArrivalProcess::FIXED), batchSize(1), traceIndex(0), generationStartTick(0),
+      pendingTick(NO_ARRIVAL), pendingCount(0) {
 }
 
 ProcessGenerator::~ProcessGenerator() {
     stopGeneration();
 }
 
+bool ProcessGenerator::setArrivalProcess(const std::string& process, int meanBatchSize, const std::string& tracePath) {
+    if (generating) {
+        return false;
+    }
+    
+    batchSize = std::max(1, meanBatchSize);
+    poissonDist = std::poisson_distribution<int>(batchSize);
+    burstDist = std::bernoulli_distribution(1.0 / BURST_SPREAD);
+    arrivalTrace.clear();
+    
+    if (process == "fixed") {
+        arrivalProcess = ArrivalProcess::FIXED;
+    } else if (process == "poisson") {
+        arrivalProcess = ArrivalProcess::POISSON;
+    } else if (process == "bursty") {
+        arrivalProcess = ArrivalProcess::BURSTY;
+    } else if (process == "trace" && loadArrivalTrace(tracePath)) {
+        arrivalProcess = ArrivalProcess::TRACE;
+    } else {
+        std::cerr << "Warning: Unusable arrival process '" << process << "', generating fixed batches" << std::endl;
+        arrivalProcess = ArrivalProcess::FIXED;
+        return false;
+    }
+    return true;
+}
+
+bool ProcessGenerator::loadArrivalTrace(const std::string& path) {
+    // One arrival per line as "<tick offset> [count]"; blank lines and # comments are skipped
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open arrival trace " << path << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') {
+            continue;
+        }
+        
+        std::string second;
+        uint64_t offset = 0;
+        int count = 1;
+        try {
+            offset = std::stoull(first);
+            if (fields >> second) {
+                count = std::stoi(second);
+            }
+        } catch (const std::exception&) {
+            count = -1;
+        }
+        if (count < 0) {
+            std::cerr << "Error: Bad arrival on line " << lineNumber << " of " << path << std::endl;
+            arrivalTrace.clear();
+            return false;
+        }
+        arrivalTrace.emplace_back(offset, count);
+    }
+    
+    std::stable_sort(arrivalTrace.begin(), arrivalTrace.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    return true;
+}
+
 void ProcessGenerator::startGeneration(int freq, int minInstructions, int maxInstructions) {
     if (generating) {
         return;
@@ -23,17 +95,67 @@ void ProcessGenerator::startGeneration(int freq, int minInstructions, int maxIns
     maxIns = maxInstructions;
     instructionDist = std::uniform_int_distribution<int>(minIns, maxIns);
     
-    generating = true;
-    generatorThread = std::thread(&ProcessGenerator::generatorLoop, this);
+    if (!processManager) {
+        std::cerr << "Error: Process manager is null, cannot start generation" << std::endl;
+        return;
+    }
+    
+    std::cout << "Process generator started" << std::endl;
     
+    // Batches are scheduled as offsets from the first tick the listener sees,
+    // so the clock moving on before it is registered shifts none of them: the
+    // first arrives on that tick, then one every batchFreq ticks
+    CpuClock& clock = processManager->getClock();
+    nextGenerationTick = 0;
+    generationStartTick = NO_ARRIVAL;
+    traceIndex = 0;
+    pendingTick = scheduleNextBatch(pendingCount);
+    generating = true;
+    builder = std::thread(&ProcessGenerator::buildBatches, this);
+    tickListenerId = clock.addTickListener([this](uint64_t tick) { onTick(tick); });
+}
+
+void ProcessGenerator::setMemoryRange(int minBytes, int maxBytes, bool issueMemoryInstructions) {
+    minMemory = minBytes;
+    maxMemory = std::max(minBytes, maxBytes);
+    memoryInstructions = issueMemoryInstructions;
+}
+
+int ProcessGenerator::drawMemorySize() {
+    // A power of two within the range, or the lower bound when none fits
+    if (minMemory <= 0) {
+        return 0;
+    }
+    int lowShift = 0;
+    while ((1 << lowShift) < minMemory) {
+        lowShift++;
+    }
+    int highShift = lowShift;
+    while (highShift < 30 && (1 << (highShift + 1)) <= maxMemory) {
+        highShift++;
+    }
+    if ((1 << lowShift) > maxMemory) {
+        return minMemory;
+    }
+    return 1 << std::uniform_int_distribution<int>(lowShift, highShift)(rng);
 }
 
 void ProcessGenerator::stopGeneration() {
     if (generating) {
-        generating = false;
-        if (generatorThread.joinable()) {
-            generatorThread.join();
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            generating = false;
         }
+        batchReady.notify_all();
+        batchTaken.notify_all();
+        
+        // Returns only once no tick is generating on our behalf
+        processManager->getClock().removeTickListener(tickListenerId);
+        tickListenerId = -1;
+        builder.join();
+        
+        // Batches built for ticks that will not come are dropped
+        readyBatches.clear();
     }
 }
 
@@ -42,9 +164,9 @@ bool ProcessGenerator::isGenerating() const {
 }
 
 std::string ProcessGenerator::generateProcessName() {
-    processCounter++;
+    int number = ++processCounter;
     std::stringstream ss;
-    ss << "p" << std::setfill('0') << std::setw(2) << processCounter;
+    ss << "p" << std::setfill('0') << std::setw(2) << number;
     return ss.str();
 }
 
@@ -63,15 +185,24 @@ std::shared_ptr<Process> ProcessGenerator::createDummyProcess() {
     std::uniform_int_distribution<int> safeInsDist(minSafeIns, maxSafeIns);
     int instructionCount = safeInsDist(rng);
     
-    int processId = processCounter;
+    int processId = processManager->nextProcessId();
     
     // Reduced verbosity - only log minimal process creation info
     // std::cout << "Created process " << name << " (ID: " << processId << ")" << std::endl;
     
     auto process = std::make_shared<Process>(name, processId, instructionCount);
     
+    // Both sizes are set so either memory model admits the same request
+    int memorySize = drawMemorySize();
+    if (memorySize > 0) {
+        process->setMemorySize(memorySize);
+        process->setVirtualMemorySize(memorySize);
+    }
+    process->setPriority(priorityDist(rng));
+    
     try {
-        auto instructions = instructionGenerator.generateRandomInstructions(name, minSafeIns, maxSafeIns);
+        size_t addressable = memoryInstructions ? static_cast<size_t>(memorySize) : 0;
+        auto instructions = instructionGenerator.generateRandomInstructions(name, minSafeIns, maxSafeIns, addressable);
         process->setInstructions(instructions);
     } catch (const std::exception& e) {
         std::cerr << "Exception while generating instructions: " << e.what() << std::endl;
@@ -91,42 +222,107 @@ int ProcessGenerator::getProcessCount() const {
     return processCounter;
 }
 
-void ProcessGenerator::generatorLoop() {
-    auto lastGeneration = std::chrono::steady_clock::now();
-    
-    std::cout << "Process generator started" << std::endl;
-              
-    // Force immediate generation of first process for testing
+void ProcessGenerator::onTick(uint64_t tick) {
+    // Runs on a CPU core at the end of every clock tick, with every core
+    // waiting on it, so it only takes batches the builder has finished
+    if (!generating) {
+        return;
+    }
+    std::vector<std::shared_ptr<Process>> due;
     {
-        auto newProcess = createDummyProcess();
-        
-        if (processManager) {
-            processManager->addGeneratedProcess(newProcess);
+        std::unique_lock<std::mutex> lock(batchMutex);
+        // A batch due now but still being built is waited for, so arrivals keep their ticks
+        if (generationStartTick == NO_ARRIVAL) {
+            generationStartTick = tick;
+        }
+        uint64_t elapsed = tick - generationStartTick;
+        batchReady.wait(lock, [&] { return !generating || pendingTick > elapsed; });
+        while (!readyBatches.empty() && readyBatches.front().tick <= elapsed) {
+            std::vector<std::shared_ptr<Process>>& processes = readyBatches.front().processes;
+            if (due.empty()) {
+                due = std::move(processes);
+            } else {
+                due.insert(due.end(), processes.begin(), processes.end());
+            }
+            readyBatches.pop_front();
         }
     }
+    if (due.empty()) {
+        return;
+    }
+    batchTaken.notify_one();
     
-    while (generating) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastGeneration);
+    // The batch is handed over whole so admission and the run queues are
+    // locked once per batch rather than once per process
+    processManager->addGeneratedProcesses(due);
+}
+
+void ProcessGenerator::buildBatches() {
+    // Stays up to READY_BATCHES ahead of the clock
+    while (true) {
+        uint64_t tick;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(batchMutex);
+            batchTaken.wait(lock, [this] { return !generating || readyBatches.size() < READY_BATCHES; });
+            if (!generating || pendingTick == NO_ARRIVAL) {
+                return;
+            }
+            tick = pendingTick;
+            count = pendingCount;
+        }
         
-        // Convert batchFreq to milliseconds (faster for testing)
-        // Lower value = faster process generation
-        int cycleTimeMs = batchFreq * 100; 
+        PendingBatch batch{tick, {}};
+        batch.processes.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            batch.processes.push_back(createDummyProcess());
+        }
+        int nextCount = 0;
+        uint64_t nextTick = scheduleNextBatch(nextCount);
         
-        if (elapsed.count() >= cycleTimeMs) {
-            // Generate new process
-            auto newProcess = createDummyProcess();
-            
-            // Add to process manager
-            if (processManager) {
-                processManager->addGeneratedProcess(newProcess);
-            } else {
-                std::cerr << "Error: Process manager is null in generator loop" << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(batchMutex);
+            readyBatches.push_back(std::move(batch));
+            pendingTick = nextTick;
+            pendingCount = nextCount;
+        }
+        batchReady.notify_all();
+    }
+}
+
+uint64_t ProcessGenerator::scheduleNextBatch(int& count) {
+    // Offset and size of the next non-empty batch, NO_ARRIVAL once a trace runs out
+    if (arrivalProcess == ArrivalProcess::TRACE) {
+        while (traceIndex < arrivalTrace.size()) {
+            uint64_t offset = arrivalTrace[traceIndex].first;
+            count = 0;
+            while (traceIndex < arrivalTrace.size() && arrivalTrace[traceIndex].first == offset) {
+                count += arrivalTrace[traceIndex].second;
+                traceIndex++;
+            }
+            if (count > 0) {
+                return offset;
             }
-            
-            lastGeneration = now;
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return NO_ARRIVAL;
+    }
+    
+    while (true) {
+        uint64_t tick = nextGenerationTick;
+        nextGenerationTick += batchFreq;
+        switch (arrivalProcess) {
+            case ArrivalProcess::POISSON:
+                count = poissonDist(rng);
+                break;
+            case ArrivalProcess::BURSTY:
+                count = burstDist(rng) ? batchSize * BURST_SPREAD : 0;
+                break;
+            default:
+                count = batchSize;
+                break;
+        }
+        if (count > 0) {
+            return tick;
+        }
     }
 }
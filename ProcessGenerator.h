@@ -2,10 +2,18 @@
 #define PROCESSGENERATOR_H
 
 #include <memory>
-#include <thread>
 #include <atomic>
+#include <cstdint>
 #include <random>
 #include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
 #include "Process.h"
 #include "InstructionGenerator.h"
 
@@ -13,24 +21,81 @@ class ProcessManager; // Forward declaration
 
 class ProcessGenerator {
 private:
+    // How the number of arrivals per batch-process-freq period is drawn
+    enum class ArrivalProcess {
+        FIXED,      // Exactly batchSize every period
+        POISSON,    // Poisson with mean batchSize
+        BURSTY,     // Mostly quiet, then BURST_SPREAD periods' worth at once
+        TRACE       // Replayed from a file of tick offsets, ignoring the period
+    };
+    
+    // A bursty period carries this many periods' worth of arrivals, so the
+    // mean rate matches the fixed process
+    static constexpr int BURST_SPREAD = 10;
+    
+    // Generated processes get a priority in [0, PRIORITY_LEVELS)
+    static constexpr int PRIORITY_LEVELS = 10;
+    
+    // Batches built ahead of the clock; more only costs memory
+    static constexpr size_t READY_BATCHES = 2;
+    static constexpr uint64_t NO_ARRIVAL = std::numeric_limits<uint64_t>::max();
+    
+    // A batch and the tick, counted from generationStartTick, it arrives on
+    struct PendingBatch {
+        uint64_t tick;
+        std::vector<std::shared_ptr<Process>> processes;
+    };
+    
     std::atomic<bool> generating;
-    std::thread generatorThread;
-    int processCounter;
+    int tickListenerId;             // Registration on the CPU clock while generating
+    uint64_t nextGenerationTick;    // Offset of the next periodic arrival, advanced by the builder
+    std::atomic<int> processCounter;
     int batchFreq;
     int minIns;
     int maxIns;
+    int minMemory;                  // Bounds of the power-of-two memory request, 0 for none
+    int maxMemory;
+    bool memoryInstructions;        // Programs READ and WRITE their memory (paged mode)
     ProcessManager* processManager;
     std::mt19937 rng;
     std::uniform_int_distribution<int> instructionDist;
+    std::uniform_int_distribution<int> priorityDist;
     InstructionGenerator instructionGenerator;
     
-    void generatorLoop();
+    ArrivalProcess arrivalProcess;
+    int batchSize;
+    std::poisson_distribution<int> poissonDist;
+    std::bernoulli_distribution burstDist;
+    std::vector<std::pair<uint64_t, int>> arrivalTrace;  // (tick offset, count), sorted by tick
+    size_t traceIndex;
+    uint64_t generationStartTick;   // First tick seen while generating, NO_ARRIVAL until then
+    
+    // Processes are created on the builder thread, so a clock tick only hands
+    // over batches that are already complete. Every arrival up to pendingTick
+    // is in readyBatches.
+    std::thread builder;
+    std::mutex batchMutex;
+    std::condition_variable batchReady;     // A batch was queued, or generation stopped
+    std::condition_variable batchTaken;     // Room in readyBatches, or generation stopped
+    std::deque<PendingBatch> readyBatches;
+    uint64_t pendingTick;                   // Arrival offset of the next batch not yet queued
+    int pendingCount;
+    
+    void onTick(uint64_t tick);
+    void buildBatches();
+    int drawMemorySize();
+    uint64_t scheduleNextBatch(int& count);
+    bool loadArrivalTrace(const std::string& path);
     
 public:
     ProcessGenerator(ProcessManager* pm);
     ~ProcessGenerator();
     
+    // Takes effect from the next startGeneration; falls back to fixed batches
+    // and returns false when the process is unknown or the trace unreadable
+    bool setArrivalProcess(const std::string& process, int meanBatchSize, const std::string& tracePath = "");
     void startGeneration(int freq, int minInstructions, int maxInstructions);
+    void setMemoryRange(int minBytes, int maxBytes, bool issueMemoryInstructions = false);
     void stopGeneration();
     bool isGenerating() const;
     
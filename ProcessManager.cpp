@@ -5,9 +5,8 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
-#include <set>
 
-ProcessManager::ProcessManager() : numCores(4), currentQuantumCycle(0), useVirtualMemory(false) {
+ProcessManager::ProcessManager() : numCores(4), currentQuantumCycle(0), useVirtualMemory(false), memorySnapshotsEnabled(true) {
     scheduler = std::make_unique<Scheduler>(this);
     generator = std::make_unique<ProcessGenerator>(this);
     memoryManager = std::make_unique<MemoryManager>(16384, 4096, 16, "F");
@@ -28,7 +27,8 @@ void ProcessManager::setConfig(const Config& config) {
     storedConfig = std::make_unique<Config>(config); // Store a copy in unique_ptr
     
     if (scheduler) {
-        scheduler->setSchedulerConfig(config.scheduler, config.quantumCycles, config.numCpu);
+        scheduler->setSchedulerConfig(config.scheduler, config.quantumCycles, config.numCpu, config.delaysPerExec);
+        scheduler->getClock().setTickPeriod(config.cpuTickMs);
     }
     
     if (memoryManager) {
@@ -46,8 +46,19 @@ void ProcessManager::setConfig(const Config& config) {
     // Initialize virtual memory manager for Phase 2 (always create it)
     vmManager = std::make_unique<VirtualMemoryManager>(
         config.maxOverallMem,
-        config.memPerFrame
+        config.memPerFrame,
+        config.pageReplacementAlg,
+        config.backingStoreSync
     );
+    vmManager->setCoreCount(config.numCpu);
+    vmManager->setBackingStoreCompaction(config.backingStoreCompact);
+    vmManager->setHugePages(config.hugePageSize, config.hugePageThreshold);
+    
+    {
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        admissionPolicy = (config.admissionPolicy == "smallest") ? AdmissionPolicy::SMALLEST_FIRST :
+                          (config.admissionPolicy == "priority") ? AdmissionPolicy::PRIORITY : AdmissionPolicy::FIFO;
+    }
 }
 
 void ProcessManager::startProcessGeneration() {
@@ -58,7 +69,7 @@ void ProcessManager::startProcessGeneration() {
         int maxIns = storedConfig->maxIns;
         
         // Sanity check the values - if they seem invalid, use sensible defaults
-        if (freq <= 0 || freq > 10) {
+        if (freq <= 0) {
             std::cout << "Warning: Invalid batch frequency value (" << freq << "), using default of 1" << std::endl;
             freq = 1;
         }
@@ -78,8 +89,16 @@ void ProcessManager::startProcessGeneration() {
         
         std::cout << "Starting process generation with config: freq=" << freq 
                   << ", minIns=" << minIns 
-                  << ", maxIns=" << maxIns << std::endl;
+                  << ", maxIns=" << maxIns
+                  << ", batch=" << storedConfig->batchSize
+                  << " (" << storedConfig->arrivalProcess << ")" << std::endl;
         
+        // Requests larger than all of memory would never be admitted. Only paged
+        // memory services READ and WRITE, so flat-memory programs leave them out.
+        generator->setMemoryRange(std::min(storedConfig->minMemPerProc, storedConfig->maxOverallMem),
+                                  std::min(storedConfig->maxMemPerProc, storedConfig->maxOverallMem),
+                                  useVirtualMemory);
+        generator->setArrivalProcess(storedConfig->arrivalProcess, storedConfig->batchSize, storedConfig->arrivalTrace);
         generator->startGeneration(freq, minIns, maxIns);
     } else if (generator) {
         // Fallback values in case config not set or error
@@ -102,20 +121,134 @@ bool ProcessManager::isGeneratingProcesses() const {
 
 void ProcessManager::addGeneratedProcess(std::shared_ptr<Process> process) {
     if (!process) return;
+    addGeneratedProcesses({process});
+}
+
+void ProcessManager::addGeneratedProcesses(const std::vector<std::shared_ptr<Process>>& batch) {
+    if (batch.empty()) return;
     
+    uint64_t arrival = getClock().now();
+    for (const auto& process : batch) {
+        process->setArrivalTick(arrival);
+    }
+    registerProcesses(batch);
+    
+    // A process that does not fit waits in the admission queue; one that
+    // would jump ahead of it waits too, so the ordering policy holds
+    std::vector<std::shared_ptr<Process>> admitted;
+    admitted.reserve(batch.size());
     {
-        std::lock_guard<std::mutex> lock(processMutex);
-        processes.push_back(process);
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        for (const auto& process : batch) {
+            std::pair<int64_t, uint64_t> key(admissionRank(*process), admissionSequence++);
+            bool memoryAllocated = false;
+            if (admissionQueue.empty() || key < admissionQueue.begin()->first) {
+                memoryAllocated = allocateMemoryToProcess(process);
+            }
+            if (memoryAllocated) {
+                admitted.push_back(process);
+            } else {
+                admissionQueue.emplace(key, process);
+            }
+        }
     }
     
-    // Try to allocate memory for the process
-    bool memoryAllocated = allocateMemoryToProcess(process);
+    if (scheduler) {
+        scheduler->addProcesses(admitted);
+    }
+}
+
+int ProcessManager::nextProcessId() {
+    return processIdCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ProcessManager::registerProcess(const std::shared_ptr<Process>& process) {
+    registerProcesses({process});
+}
+
+void ProcessManager::registerProcesses(const std::vector<std::shared_ptr<Process>>& batch) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    for (const auto& process : batch) {
+        processesByPid[process->getProcessId()] = process;
+        processesByName[process->getName()] = process;
+        runningProcesses[process->getProcessId()] = process;
+    }
+}
+
+void ProcessManager::onProcessFinished(const std::shared_ptr<Process>& process) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    if (runningProcesses.erase(process->getProcessId()) == 0) {
+        return;
+    }
+    finishedProcesses.push_back(process);
+    ++finishedProcessCount;
     
-    // Only add process to scheduler if memory was successfully allocated
-    if (memoryAllocated && scheduler) {
-        scheduler->addProcess(process);
+    // Age out the oldest; a name or pid reused since then keeps its newer owner
+    while (finishedProcesses.size() > finishedHistoryLimit) {
+        std::shared_ptr<Process> oldest = std::move(finishedProcesses.front());
+        finishedProcesses.pop_front();
+        auto byPid = processesByPid.find(oldest->getProcessId());
+        if (byPid != processesByPid.end() && byPid->second == oldest) {
+            processesByPid.erase(byPid);
+        }
+        auto byName = processesByName.find(oldest->getName());
+        if (byName != processesByName.end() && byName->second == oldest) {
+            processesByName.erase(byName);
+        }
+    }
+}
+
+void ProcessManager::setFinishedHistoryLimit(size_t limit) {
+    std::lock_guard<std::mutex> lock(processMutex);
+    finishedHistoryLimit = limit;
+}
+
+int64_t ProcessManager::admissionRank(const Process& process) const {
+    switch (admissionPolicy) {
+        case AdmissionPolicy::SMALLEST_FIRST:
+            return static_cast<int64_t>(requestedMemory(process));
+        case AdmissionPolicy::PRIORITY:
+            return -static_cast<int64_t>(process.getPriority());
+        default:
+            return 0;
+    }
+}
+
+size_t ProcessManager::requestedMemory(const Process& process) const {
+    // The process's own size, or mem-per-proc when it was created without one
+    size_t ownSize = useVirtualMemory ? process.getVirtualMemorySize() : static_cast<size_t>(process.getMemorySize());
+    if (ownSize > 0) {
+        return ownSize;
     }
-    // If memory allocation failed, the process will remain in processes list but not in the ready queue
+    return (storedConfig && storedConfig->memPerProc > 0) ? storedConfig->memPerProc : 4096;
+}
+
+void ProcessManager::drainAdmissionQueue() {
+    // Strictly in order: when the head does not fit, later processes wait
+    // behind it rather than starve it
+    std::vector<std::shared_ptr<Process>> admitted;
+    {
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        while (!admissionQueue.empty()) {
+            auto head = admissionQueue.begin();
+            if (head->second->getIsActive() && !allocateMemoryToProcess(head->second)) {
+                break;
+            }
+            if (head->second->getIsActive()) {
+                admitted.push_back(head->second);
+            }
+            admissionQueue.erase(head);
+        }
+    }
+    
+    if (scheduler) {
+        scheduler->addProcesses(admitted);
+    }
+}
+
+size_t ProcessManager::getAdmissionQueueLength() const {
+    std::lock_guard<std::mutex> lock(admissionMutex);
+    return admissionQueue.size();
 }
 
 void ProcessManager::initialize() {
@@ -145,10 +278,9 @@ void ProcessManager::startScheduler() {
     try {
         // Only add processes that have memory allocated
         int addedProcesses = 0;
-        int waitingForMemory = 0;
         {
             std::lock_guard<std::mutex> lock(processMutex);
-            for (auto& process : processes) {
+            for (auto& [pid, process] : runningProcesses) {
                 if (!process) {
                     std::cerr << "Warning: Null process in processes list" << std::endl;
                     continue;
@@ -163,28 +295,15 @@ void ProcessManager::startScheduler() {
                         std::cerr << "Failed to add process " << process->getName() 
                                  << " to scheduler: " << e.what() << std::endl;
                     }
-                } else {
-                    waitingForMemory++;
-                    // Try to allocate memory for processes that don't have it yet
-                    if (memoryManager && !process->getHasMemoryAllocated()) {
-                        bool allocated = allocateMemoryToProcess(process);
-                        if (allocated) {
-                            try {
-                                scheduler->addProcess(process);
-                                addedProcesses++;
-                                waitingForMemory--;
-                            } catch (const std::exception& e) {
-                                std::cerr << "Failed to add newly allocated process " << process->getName() 
-                                         << " to scheduler: " << e.what() << std::endl;
-                            }
-                        }
-                    }
                 }
             }
         }
         
+        // The rest are in the admission queue, which is drained as memory frees up
+        drainAdmissionQueue();
+        
         std::cout << "Scheduler startup summary: " << addedProcesses << " processes added, " 
-                 << waitingForMemory << " waiting for memory allocation" << std::endl;
+                 << getAdmissionQueueLength() << " waiting for memory allocation" << std::endl;
                  
     } catch (const std::exception& e) {
         std::cerr << "Exception in startScheduler: " << e.what() << std::endl;
@@ -197,6 +316,12 @@ void ProcessManager::stopScheduler() {
     }
 }
 
+void ProcessManager::haltScheduler() {
+    if (scheduler) {
+        scheduler->halt();
+    }
+}
+
 void ProcessManager::showProcessStatus() {
     std::cout << "\n-----------------------------------------" << std::endl;
     
@@ -215,41 +340,37 @@ void ProcessManager::showProcessStatus() {
     
     std::cout << "Running processes:" << std::endl;
     
-    for (const auto& process : processes) {
-        if (process->getIsActive()) {
-            std::cout << std::left << std::setw(12) << process->getName() << " ";
-            std::cout << "(" << process->getCreationDate() << ")";
-            
-            int coreId = getProcessCore(process->getProcessId());
-            if (coreId >= 0) {
-                std::cout << "     Core: " << std::setw(2) << coreId << "    ";
-            } else {
-                std::cout << "     Core: --    ";
-            }
-            
-            std::cout << std::setw(5) << process->getCurrentLine() << " / " << process->getTotalLines();
-            
-            // Add memory allocation status
-            if (process->getHasMemoryAllocated()) {
-                std::cout << "    [Memory: " << process->getMemoryStartAddress() 
-                         << "-" << process->getMemoryEndAddress() << "]";
-            } else {
-                std::cout << "    [Memory: Waiting]";
-            }
-            
-            std::cout << std::endl;
+    for (const auto& process : getRunningProcesses()) {
+        std::cout << std::left << std::setw(12) << process->getName() << " ";
+        std::cout << "(" << process->getCreationDate() << ")";
+        
+        int coreId = getProcessCore(process->getProcessId());
+        if (coreId >= 0) {
+            std::cout << "     Core: " << std::setw(2) << coreId << "    ";
+        } else {
+            std::cout << "     Core: --    ";
         }
+        
+        std::cout << std::setw(5) << process->getCurrentLine() << " / " << process->getTotalLines();
+        
+        // Add memory allocation status
+        if (process->getHasMemoryAllocated()) {
+            std::cout << "    [Memory: " << process->getMemoryStartAddress() 
+                     << "-" << process->getMemoryEndAddress() << "]";
+        } else {
+            std::cout << "    [Memory: Waiting]";
+        }
+        
+        std::cout << std::endl;
     }
     
     std::cout << "\nFinished processes:" << std::endl;
-    for (const auto& process : processes) {
-        if (!process->getIsActive()) {
-            std::cout << std::left << std::setw(12) << process->getName() << " ";
-            std::cout << "(" << process->getCreationDate() << ")";
-            std::cout << "     Finished    ";
-            std::cout << std::setw(5) << process->getTotalLines() << " / " << process->getTotalLines();
-            std::cout << std::endl;
-        }
+    for (const auto& process : getFinishedProcesses()) {
+        std::cout << std::left << std::setw(12) << process->getName() << " ";
+        std::cout << "(" << process->getCreationDate() << ")";
+        std::cout << "     Finished    ";
+        std::cout << std::setw(5) << process->getTotalLines() << " / " << process->getTotalLines();
+        std::cout << std::endl;
     }
     
     std::cout << "\nMemory snapshot saved to memory_stamp_" 
@@ -261,7 +382,9 @@ void ProcessManager::showProcessStatus() {
 std::vector<std::shared_ptr<Process>> ProcessManager::getRunningProcesses() const {
     std::lock_guard<std::mutex> lock(processMutex);
     std::vector<std::shared_ptr<Process>> running;
-    for (const auto& process : processes) {
+    running.reserve(runningProcesses.size());
+    for (const auto& [pid, process] : runningProcesses) {
+        // A process that just retired stays here until the Scheduler reports it
         if (process->getIsActive()) {
             running.push_back(process);
         }
@@ -271,33 +394,33 @@ std::vector<std::shared_ptr<Process>> ProcessManager::getRunningProcesses() cons
 
 std::vector<std::shared_ptr<Process>> ProcessManager::getFinishedProcesses() const {
     std::lock_guard<std::mutex> lock(processMutex);
-    std::vector<std::shared_ptr<Process>> finished;
-    for (const auto& process : processes) {
-        if (!process->getIsActive()) {
-            finished.push_back(process);
-        }
-    }
-    return finished;
+    return std::vector<std::shared_ptr<Process>>(finishedProcesses.begin(), finishedProcesses.end());
 }
 
 std::vector<std::shared_ptr<Process>> ProcessManager::getAllProcesses() const {
     std::lock_guard<std::mutex> lock(processMutex);
-    return processes;
+    std::vector<std::shared_ptr<Process>> all(finishedProcesses.begin(), finishedProcesses.end());
+    for (const auto& [pid, process] : runningProcesses) {
+        all.push_back(process);
+    }
+    return all;
 }
 
 std::shared_ptr<Process> ProcessManager::findProcessByName(const std::string& name) const {
     std::lock_guard<std::mutex> lock(processMutex);
-    for (const auto& process : processes) {
-        if (process->getName() == name) {
-            return process;
-        }
-    }
-    return nullptr;
+    auto it = processesByName.find(name);
+    return (it != processesByName.end()) ? it->second : nullptr;
+}
+
+std::shared_ptr<Process> ProcessManager::findProcessById(int processId) const {
+    std::lock_guard<std::mutex> lock(processMutex);
+    auto it = processesByPid.find(processId);
+    return (it != processesByPid.end()) ? it->second : nullptr;
 }
 
 bool ProcessManager::hasActiveProcesses() const {
     std::lock_guard<std::mutex> lock(processMutex);
-    for (const auto& process : processes) {
+    for (const auto& [pid, process] : runningProcesses) {
         if (process->getIsActive()) {
             return true;
         }
@@ -310,17 +433,7 @@ int ProcessManager::getNumCores() const {
 }
 
 int ProcessManager::getUsedCores() const {
-    std::lock_guard<std::mutex> lock(processMutex);
-    std::set<int> usedCores;
-    for (const auto& process : processes) {
-        if (process->getIsActive()) {
-            int core = getProcessCore(process->getProcessId());
-            if (core >= 0) {
-                usedCores.insert(core);
-            }
-        }
-    }
-    return usedCores.size();
+    return scheduler ? scheduler->getBusyCoreCount() : 0;
 }
 
 double ProcessManager::getCpuUtilization() const {
@@ -328,19 +441,50 @@ double ProcessManager::getCpuUtilization() const {
     return (static_cast<double>(getUsedCores()) / numCores) * 100.0;
 }
 
-void ProcessManager::updateProcessCore(int processId, int coreId) {
-    processCoreMap[processId] = coreId;
+int ProcessManager::getProcessCore(int processId) const {
+    return scheduler ? scheduler->getProcessCore(processId) : -1;
 }
 
-int ProcessManager::getProcessCore(int processId) const {
-    auto it = processCoreMap.find(processId);
-    return (it != processCoreMap.end()) ? it->second : -1;
+std::vector<CoreOccupancy> ProcessManager::getCoreOccupancy() const {
+    return scheduler ? scheduler->getCoreOccupancy() : std::vector<CoreOccupancy>();
 }
 
 void ProcessManager::sleepCurrentProcess(int ticks) {
-    // Simulate sleeping by adding a delay for the specified number of ticks
+    // Wait out the ticks on the shared CPU clock
     std::cout << "Process sleeping for " << ticks << " ticks.\n";
-    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * 10)); // Simulate each tick as 10ms
+    if (scheduler && ticks > 0) {
+        scheduler->getClock().waitTicks(static_cast<uint64_t>(ticks));
+    }
+}
+
+CpuClock& ProcessManager::getClock() {
+    return scheduler->getClock();
+}
+
+uint64_t ProcessManager::getCompletedProcessCount() const {
+    return scheduler ? scheduler->getCompletedProcessCount() : 0;
+}
+
+int ProcessManager::getExternalFragmentation() const {
+    // Only the flat allocator fragments; paged memory hands out whole frames
+    if (!useVirtualMemory && memoryManager) {
+        return memoryManager->calculateExternalFragmentation();
+    }
+    return 0;
+}
+
+int ProcessManager::getInternalFragmentation() const {
+    if (!useVirtualMemory && memoryManager) {
+        return memoryManager->calculateInternalFragmentation();
+    }
+    return 0;
+}
+
+uint64_t ProcessManager::getPageFaultCount() const {
+    if (useVirtualMemory && vmManager) {
+        return vmManager->getMemoryStats().pageFaults;
+    }
+    return 0;
 }
 
 bool ProcessManager::allocateMemoryToProcess(std::shared_ptr<Process> process) {
@@ -354,14 +498,8 @@ bool ProcessManager::allocateMemoryToProcess(std::shared_ptr<Process> process) {
         return true;
     }
     
-    // Get the required memory size from config or use default
-    int memSize = storedConfig ? storedConfig->memPerProc : 4096;
-    
-    // Safety check for memory size
-    if (memSize <= 0) {
-        std::cerr << "Invalid memory size configured: " << memSize << std::endl;
-        memSize = 4096; // Use default if invalid
-    }
+    // The same size the admission ranking used
+    int memSize = static_cast<int>(requestedMemory(*process));
     
     bool allocated = false;
     
@@ -387,6 +525,7 @@ bool ProcessManager::allocateMemoryToProcess(std::shared_ptr<Process> process) {
         }
         
         try {
+            process->setMemorySize(memSize);
             allocated = memoryManager->allocateMemory(process);
         } catch (const std::exception& e) {
             std::cerr << "Exception during memory allocation: " << e.what() << std::endl;
@@ -438,10 +577,13 @@ void ProcessManager::releaseProcessMemory(std::shared_ptr<Process> process) {
     
     // Update process state
     process->setHasMemoryAllocated(false);
+    
+    // The freed memory may fit whoever is waiting
+    drainAdmissionQueue();
 }
 
 void ProcessManager::generateMemorySnapshot() {
-    if (memoryManager) {
+    if (memoryManager && memorySnapshotsEnabled) {
         memoryManager->setCurrentQuantum(currentQuantumCycle);
         memoryManager->generateMemorySnapshot(currentQuantumCycle);
     }
@@ -456,6 +598,10 @@ int ProcessManager::getCurrentQuantumCycle() const {
     return currentQuantumCycle;
 }
 
+void ProcessManager::setMemorySnapshotsEnabled(bool enabled) {
+    memorySnapshotsEnabled = enabled;
+}
+
 // Virtual memory management methods (Phase 2)
 void ProcessManager::enableVirtualMemory(bool enable) {
     useVirtualMemory = enable;
@@ -467,9 +613,7 @@ bool ProcessManager::isVirtualMemoryEnabled() const {
 }
 
 std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name) {
-    static int processIdCounter = 1000; // Start with higher IDs for manually created processes
-    
-    auto process = std::make_shared<Process>(name, processIdCounter++);
+    auto process = std::make_shared<Process>(name, nextProcessId());
     
     // Generate default instructions (4000 instructions as per test config)
     std::vector<std::string> instructions;
@@ -480,8 +624,7 @@ std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name)
     
     // Allocate memory using current memory manager
     if (memoryManager && memoryManager->allocateMemory(process)) {
-        std::lock_guard<std::mutex> lock(processMutex);
-        processes.push_back(process);
+        registerProcess(process);
         
         // Add to scheduler
         if (scheduler) {
@@ -495,9 +638,7 @@ std::shared_ptr<Process> ProcessManager::createProcess(const std::string& name)
 }
 
 std::shared_ptr<Process> ProcessManager::createProcessWithMemory(const std::string& name, size_t memorySize, const std::vector<std::string>& instructions) {
-    static int processIdCounter = 1000; // Start with higher IDs for manually created processes
-    
-    auto process = std::make_shared<Process>(name, processIdCounter++);
+    auto process = std::make_shared<Process>(name, nextProcessId());
     
     if (useVirtualMemory && vmManager) {
         // Phase 2: Use virtual memory
@@ -524,10 +665,7 @@ std::shared_ptr<Process> ProcessManager::createProcessWithMemory(const std::stri
     }
     
     // Add to process list
-    {
-        std::lock_guard<std::mutex> lock(processMutex);
-        processes.push_back(process);
-    }
+    registerProcess(process);
     
     // Add to scheduler for execution and ensure scheduler is running
     if (scheduler) {
@@ -540,10 +678,10 @@ std::shared_ptr<Process> ProcessManager::createProcessWithMemory(const std::stri
     return process;
 }
 
-uint16_t ProcessManager::readProcessMemory(int processId, uint32_t virtualAddr) {
+uint16_t ProcessManager::readProcessMemory(int processId, uint32_t virtualAddr, int coreId) {
     if (useVirtualMemory && vmManager) {
         try {
-            return vmManager->readMemory(processId, virtualAddr);
+            return vmManager->readMemory(processId, virtualAddr, coreId);
         } catch (const PageFaultException& e) {
             std::cout << "Page fault handled for process " << processId 
                       << " at address 0x" << std::hex << virtualAddr << std::dec << std::endl;
@@ -557,10 +695,10 @@ uint16_t ProcessManager::readProcessMemory(int processId, uint32_t virtualAddr)
     }
 }
 
-void ProcessManager::writeProcessMemory(int processId, uint32_t virtualAddr, uint16_t value) {
+void ProcessManager::writeProcessMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId) {
     if (useVirtualMemory && vmManager) {
         try {
-            vmManager->writeMemory(processId, virtualAddr, value);
+            vmManager->writeMemory(processId, virtualAddr, value, coreId);
         } catch (const PageFaultException& e) {
             std::cout << "Page fault handled for process " << processId 
                       << " at address 0x" << std::hex << virtualAddr << std::dec << std::endl;
@@ -573,6 +711,28 @@ void ProcessManager::writeProcessMemory(int processId, uint32_t virtualAddr, uin
     }
 }
 
+bool ProcessManager::tryReadProcessMemory(int processId, uint32_t virtualAddr, uint16_t& value, int coreId) {
+    if (useVirtualMemory && vmManager) {
+        return vmManager->tryReadMemory(processId, virtualAddr, value, coreId);
+    }
+    value = readProcessMemory(processId, virtualAddr, coreId);
+    return true;
+}
+
+bool ProcessManager::tryWriteProcessMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId) {
+    if (useVirtualMemory && vmManager) {
+        return vmManager->tryWriteMemory(processId, virtualAddr, value, coreId);
+    }
+    writeProcessMemory(processId, virtualAddr, value, coreId);
+    return true;
+}
+
+void ProcessManager::servicePageFault(int processId, uint32_t virtualAddr) {
+    if (useVirtualMemory && vmManager) {
+        vmManager->handlePageFault(processId, virtualAddr);
+    }
+}
+
 ProcessManager::DetailedStats ProcessManager::getDetailedStats() const {
     DetailedStats stats = {};
     
@@ -581,10 +741,10 @@ ProcessManager::DetailedStats ProcessManager::getDetailedStats() const {
     
     {
         std::lock_guard<std::mutex> lock(processMutex);
-        stats.totalProcessCount = processes.size();
+        stats.totalProcessCount = static_cast<int>(runningProcesses.size() + finishedProcessCount);
         stats.runningProcessCount = 0;
         
-        for (const auto& process : processes) {
+        for (const auto& [pid, process] : runningProcesses) {
             if (process->getIsActive()) {
                 stats.runningProcessCount++;
             }
@@ -599,25 +759,46 @@ ProcessManager::DetailedStats ProcessManager::getDetailedStats() const {
         stats.freeMemory = vmStats.freeMemory;
         stats.pagesIn = vmStats.pagesIn;
         stats.pagesOut = vmStats.pagesOut;
+        stats.zeroFillFaults = vmStats.zeroFillFaults;
+        stats.prefetchedPages = vmStats.prefetchedPages;
+        stats.prefetchHits = vmStats.prefetchHits;
+        stats.prefetchWasted = vmStats.prefetchWasted;
         stats.pageFaults = vmStats.pageFaults;
+        stats.tlbHits = vmStats.tlbHits;
+        stats.tlbMisses = vmStats.tlbMisses;
+        stats.backingStoreSize = vmStats.backingStoreSize;
+        stats.backingStoreUsed = vmStats.backingStoreUsed;
     } else {
         // Phase 1: Get basic memory stats
         if (memoryManager && storedConfig) {
             stats.totalMemory = storedConfig->maxOverallMem;
-            int processesInMemory = memoryManager->getProcessesInMemory();
-            int memPerProc = (storedConfig->minMemPerProc > 0) ? storedConfig->minMemPerProc : storedConfig->memPerProc;
-            stats.usedMemory = processesInMemory * memPerProc;
+            stats.usedMemory = memoryManager->getAllocatedMemory();
             stats.freeMemory = stats.totalMemory - stats.usedMemory;
+            stats.externalFragmentation = memoryManager->calculateExternalFragmentation();
+            stats.internalFragmentation = memoryManager->calculateInternalFragmentation();
         }
         stats.pagesIn = 0;
         stats.pagesOut = 0;
         stats.pageFaults = 0;
     }
     
-    // CPU tick estimation (simplified)
-    stats.totalCpuTicks = currentQuantumCycle * numCores;
-    stats.activeCpuTicks = static_cast<uint64_t>(stats.totalCpuTicks * (stats.cpuUtilization / 100.0));
-    stats.idleCpuTicks = stats.totalCpuTicks - stats.activeCpuTicks;
+    if (scheduler) {
+        stats.queuedProcessCount = scheduler->getQueuedProcessCount();
+        stats.sleepingProcessCount = scheduler->getSleepingProcessCount();
+        stats.blockedProcessCount = scheduler->getBlockedProcessCount();
+        stats.admissionQueueLength = getAdmissionQueueLength();
+        stats.runQueueSteals = scheduler->getStealCount();
+        stats.runQueueDepths = scheduler->getQueueDepths();
+        
+        // Counted by each core as it spends its ticks
+        CpuTickCounts ticks = scheduler->getCpuTickCounts();
+        stats.activeCpuTicks = ticks.busyTicks;
+        stats.idleCpuTicks = ticks.idleTicks;
+        stats.totalCpuTicks = ticks.busyTicks + ticks.idleTicks;
+        stats.instructionsRetired = ticks.instructionsRetired;
+        stats.averageCpuUtilization = stats.totalCpuTicks > 0 ?
+            static_cast<double>(stats.activeCpuTicks) / stats.totalCpuTicks * 100.0 : 0.0;
+    }
     
     return stats;
 }
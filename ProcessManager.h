@@ -4,6 +4,9 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <deque>
+#include <atomic>
 #include <mutex>
 #include <string>
 #include "Process.h"
@@ -16,17 +19,40 @@ struct Config; // Forward declaration
 
 class ProcessManager {
 private:
-    std::vector<std::shared_ptr<Process>> processes;
+    // Process table. Every process is indexed by pid and by name; the ones
+    // still running are kept apart, in pid (creation) order, and finished
+    // ones move to a bounded history whose oldest entries leave the table.
+    static constexpr size_t DEFAULT_FINISHED_HISTORY = 1024;
+    std::unordered_map<int, std::shared_ptr<Process>> processesByPid;
+    std::unordered_map<std::string, std::shared_ptr<Process>> processesByName;
+    std::map<int, std::shared_ptr<Process>> runningProcesses;
+    std::deque<std::shared_ptr<Process>> finishedProcesses;    // Oldest first
+    size_t finishedHistoryLimit = DEFAULT_FINISHED_HISTORY;
+    uint64_t finishedProcessCount = 0;                          // Including those aged out
+    std::atomic<int> processIdCounter{1};                       // Shared by every way of creating a process
     std::unique_ptr<Scheduler> scheduler;
     std::unique_ptr<ProcessGenerator> generator;
     std::unique_ptr<MemoryManager> memoryManager;
     std::unique_ptr<VirtualMemoryManager> vmManager;
-    std::map<int, int> processCoreMap;          // maps processId:coreId pairs
     mutable std::mutex processMutex;            // For thread-safe process operations
+    
+    // Processes waiting for memory, admitted in order whenever memory is
+    // released. The key is (policy rank, arrival sequence), so ties are FIFO.
+    enum class AdmissionPolicy { FIFO, SMALLEST_FIRST, PRIORITY };
+    AdmissionPolicy admissionPolicy = AdmissionPolicy::FIFO;
+    std::map<std::pair<int64_t, uint64_t>, std::shared_ptr<Process>> admissionQueue;
+    uint64_t admissionSequence = 0;
+    mutable std::mutex admissionMutex;          // Held across allocation so admissions cannot overtake
     int numCores;
     std::unique_ptr<Config> storedConfig; // Store copy of config
     int currentQuantumCycle; // Current quantum cycle counter
     bool useVirtualMemory; // Phase 2 feature flag
+    bool memorySnapshotsEnabled; // Off for headless simulation runs
+    
+    void registerProcess(const std::shared_ptr<Process>& process);
+    void registerProcesses(const std::vector<std::shared_ptr<Process>>& batch);
+    int64_t admissionRank(const Process& process) const;
+    size_t requestedMemory(const Process& process) const;
 
 public:
     ProcessManager();
@@ -35,6 +61,7 @@ public:
     void initialize();
     void startScheduler();
     void stopScheduler();
+    void haltScheduler();
     void showProcessStatus();
     
     // For the process generation and basing on the config 
@@ -43,13 +70,22 @@ public:
     void stopProcessGeneration();
     bool isGeneratingProcesses() const;
     void addGeneratedProcess(std::shared_ptr<Process> process);
+    void addGeneratedProcesses(const std::vector<std::shared_ptr<Process>>& batch);
+    int nextProcessId();
+    
+    // Called by the Scheduler when a process retires its last instruction
+    void onProcessFinished(const std::shared_ptr<Process>& process);
+    void setFinishedHistoryLimit(size_t limit);
     
     // Memory management
     bool allocateMemoryToProcess(std::shared_ptr<Process> process);
     void releaseProcessMemory(std::shared_ptr<Process> process);
+    void drainAdmissionQueue();                 // Admit waiting processes until the first that does not fit
+    size_t getAdmissionQueueLength() const;
     void generateMemorySnapshot();
     void incrementQuantumCycle();
     int getCurrentQuantumCycle() const;
+    void setMemorySnapshotsEnabled(bool enabled);
     
     // Process accessing like screen and report util
     std::vector<std::shared_ptr<Process>> getRunningProcesses() const;
@@ -57,23 +93,36 @@ public:
     std::vector<std::shared_ptr<Process>> getAllProcesses() const;
     bool hasActiveProcesses() const;
     std::shared_ptr<Process> findProcessByName(const std::string& name) const;
+    std::shared_ptr<Process> findProcessById(int processId) const;
     
     // Core management
-    void updateProcessCore(int processId, int coreId);
     int getProcessCore(int processId) const;
+    std::vector<CoreOccupancy> getCoreOccupancy() const;   // Indexed by core
     int getNumCores() const;
     int getUsedCores() const;
     double getCpuUtilization() const;
 
     void sleepCurrentProcess(int ticks);
+    CpuClock& getClock();
+    uint64_t getCompletedProcessCount() const;
+    
+    // Cheap samples for the headless simulator
+    int getExternalFragmentation() const;
+    int getInternalFragmentation() const;
+    uint64_t getPageFaultCount() const;
     
     // Virtual memory management methods (Phase 2)
     void enableVirtualMemory(bool enable);
     bool isVirtualMemoryEnabled() const;
     std::shared_ptr<Process> createProcess(const std::string& name);
     std::shared_ptr<Process> createProcessWithMemory(const std::string& name, size_t memorySize, const std::vector<std::string>& instructions = {});
-    uint16_t readProcessMemory(int processId, uint32_t virtualAddr);
-    void writeProcessMemory(int processId, uint32_t virtualAddr, uint16_t value);
+    uint16_t readProcessMemory(int processId, uint32_t virtualAddr, int coreId = -1);
+    void writeProcessMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId = -1);
+    
+    // Scheduler path: false means a page fault must be serviced before retrying
+    bool tryReadProcessMemory(int processId, uint32_t virtualAddr, uint16_t& value, int coreId);
+    bool tryWriteProcessMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId);
+    void servicePageFault(int processId, uint32_t virtualAddr);
     
     // Enhanced statistics for Phase 2
     struct DetailedStats {
@@ -83,12 +132,30 @@ public:
         uint64_t totalCpuTicks;
         uint64_t idleCpuTicks;
         uint64_t activeCpuTicks;
+        uint64_t instructionsRetired;
+        double averageCpuUtilization;       // Busy share of every core tick so far
         uint64_t pagesIn;
         uint64_t pagesOut;
+        uint64_t zeroFillFaults = 0;
+        uint64_t prefetchedPages = 0;
+        uint64_t prefetchHits = 0;
+        uint64_t prefetchWasted = 0;
         uint64_t pageFaults;
+        uint64_t tlbHits;
+        uint64_t tlbMisses;
+        uint64_t backingStoreSize;
+        uint64_t backingStoreUsed;
+        int externalFragmentation;
+        int internalFragmentation;
         double cpuUtilization;
         int runningProcessCount;
         int totalProcessCount;
+        int queuedProcessCount;
+        size_t sleepingProcessCount;
+        int blockedProcessCount;
+        size_t admissionQueueLength;
+        uint64_t runQueueSteals;
+        std::vector<int> runQueueDepths;
     };
     
     DetailedStats getDetailedStats() const;
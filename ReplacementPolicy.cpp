@@ -0,0 +1,330 @@
+#include "ReplacementPolicy.h"
+#include <algorithm>
+
+// FrameList Implementation
+FrameList::FrameList(int totalFrames)
+    : prev(totalFrames, -1), next(totalFrames, -1), linked(totalFrames, 0) {
+}
+
+void FrameList::pushFront(int frame) {
+    prev[frame] = -1;
+    next[frame] = head;
+    if (head != -1) {
+        prev[head] = frame;
+    } else {
+        tail = frame;
+    }
+    head = frame;
+    linked[frame] = 1;
+    ++count;
+}
+
+void FrameList::pushBack(int frame) {
+    next[frame] = -1;
+    prev[frame] = tail;
+    if (tail != -1) {
+        next[tail] = frame;
+    } else {
+        head = frame;
+    }
+    tail = frame;
+    linked[frame] = 1;
+    ++count;
+}
+
+void FrameList::remove(int frame) {
+    if (!linked[frame]) {
+        return;
+    }
+    if (prev[frame] != -1) {
+        next[prev[frame]] = next[frame];
+    } else {
+        head = next[frame];
+    }
+    if (next[frame] != -1) {
+        prev[next[frame]] = prev[frame];
+    } else {
+        tail = prev[frame];
+    }
+    prev[frame] = next[frame] = -1;
+    linked[frame] = 0;
+    --count;
+}
+
+// Factory
+std::unique_ptr<ReplacementPolicy> ReplacementPolicy::create(const std::string& name, int totalFrames) {
+    if (name == "FIFO") {
+        return std::make_unique<FifoPolicy>(totalFrames);
+    }
+    if (name == "CLOCK") {
+        return std::make_unique<ClockPolicy>(totalFrames);
+    }
+    if (name == "SECOND-CHANCE") {
+        return std::make_unique<SecondChancePolicy>(totalFrames);
+    }
+    if (name == "LFU") {
+        return std::make_unique<LfuPolicy>(totalFrames);
+    }
+    if (name == "ARC") {
+        return std::make_unique<ArcPolicy>(totalFrames);
+    }
+    return std::make_unique<LruPolicy>(totalFrames);
+}
+
+// LruPolicy Implementation
+void LruPolicy::onLoad(int frame, uint64_t /*pageKey*/) {
+    recency.pushFront(frame);
+}
+
+void LruPolicy::onAccess(int frame) {
+    if (recency.contains(frame) && recency.front() != frame) {
+        recency.remove(frame);
+        recency.pushFront(frame);
+    }
+}
+
+void LruPolicy::onRelease(int frame) {
+    recency.remove(frame);
+}
+
+int LruPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    return recency.back();
+}
+
+// FifoPolicy Implementation
+void FifoPolicy::onLoad(int frame, uint64_t /*pageKey*/) {
+    arrival.pushBack(frame);
+}
+
+void FifoPolicy::onRelease(int frame) {
+    arrival.remove(frame);
+}
+
+int FifoPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    return arrival.front();
+}
+
+// ClockPolicy Implementation
+void ClockPolicy::onLoad(int frame, uint64_t /*pageKey*/) {
+    if (!resident[frame]) {
+        resident[frame] = 1;
+        ++residentCount;
+    }
+}
+
+void ClockPolicy::onRelease(int frame) {
+    if (resident[frame]) {
+        resident[frame] = 0;
+        --residentCount;
+    }
+}
+
+int ClockPolicy::selectVictim(const ReferenceProbe& testAndClearReferenced) {
+    if (residentCount == 0) {
+        return -1;
+    }
+    // Terminates within two sweeps: the first clears every referenced bit
+    int totalFrames = static_cast<int>(resident.size());
+    while (true) {
+        int frame = hand;
+        hand = (hand + 1) % totalFrames;
+        if (resident[frame] && !testAndClearReferenced(frame)) {
+            return frame;
+        }
+    }
+}
+
+// SecondChancePolicy Implementation
+void SecondChancePolicy::onLoad(int frame, uint64_t /*pageKey*/) {
+    arrival.pushBack(frame);
+}
+
+void SecondChancePolicy::onRelease(int frame) {
+    arrival.remove(frame);
+}
+
+int SecondChancePolicy::selectVictim(const ReferenceProbe& testAndClearReferenced) {
+    while (!arrival.empty()) {
+        int frame = arrival.front();
+        if (!testAndClearReferenced(frame)) {
+            return frame;
+        }
+        // Referenced since it was queued: clear the bit and send it to the back
+        arrival.remove(frame);
+        arrival.pushBack(frame);
+    }
+    return -1;
+}
+
+// LfuPolicy Implementation
+LfuPolicy::LfuPolicy(int totalFrames)
+    : frequency(totalFrames, 0), prev(totalFrames, -1), next(totalFrames, -1) {
+}
+
+void LfuPolicy::link(int frame) {
+    Bucket& bucket = buckets[frequency[frame]];
+    prev[frame] = -1;
+    next[frame] = bucket.head;
+    if (bucket.head != -1) {
+        prev[bucket.head] = frame;
+    } else {
+        bucket.tail = frame;
+    }
+    bucket.head = frame;
+}
+
+void LfuPolicy::unlink(int frame) {
+    auto it = buckets.find(frequency[frame]);
+    Bucket& bucket = it->second;
+    if (prev[frame] != -1) {
+        next[prev[frame]] = next[frame];
+    } else {
+        bucket.head = next[frame];
+    }
+    if (next[frame] != -1) {
+        prev[next[frame]] = prev[frame];
+    } else {
+        bucket.tail = prev[frame];
+    }
+    prev[frame] = next[frame] = -1;
+    if (bucket.head == -1) {
+        buckets.erase(it);
+    }
+}
+
+void LfuPolicy::onLoad(int frame, uint64_t /*pageKey*/) {
+    if (frequency[frame] != 0) {
+        unlink(frame);
+    }
+    frequency[frame] = 1;
+    link(frame);
+    minFrequency = 1;
+}
+
+void LfuPolicy::onAccess(int frame) {
+    if (frequency[frame] == 0) {
+        return;
+    }
+    uint32_t old = frequency[frame];
+    unlink(frame);
+    if (old == minFrequency && buckets.find(old) == buckets.end()) {
+        minFrequency = old + 1;
+    }
+    frequency[frame] = old + 1;
+    link(frame);
+}
+
+void LfuPolicy::onRelease(int frame) {
+    if (frequency[frame] == 0) {
+        return;
+    }
+    unlink(frame);
+    frequency[frame] = 0;
+}
+
+int LfuPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    if (buckets.empty()) {
+        return -1;
+    }
+    // A release may have emptied the minimum bucket; recover it lazily
+    auto it = buckets.find(minFrequency);
+    if (it == buckets.end()) {
+        minFrequency = buckets.begin()->first;
+        for (const auto& [count, bucket] : buckets) {
+            minFrequency = std::min(minFrequency, count);
+        }
+        it = buckets.find(minFrequency);
+    }
+    return it->second.tail;
+}
+
+// ArcPolicy Implementation
+ArcPolicy::ArcPolicy(int totalFrames)
+    : capacity(totalFrames), t1(totalFrames), t2(totalFrames), frameKeys(totalFrames, 0) {
+}
+
+void ArcPolicy::remember(GhostList& list, uint64_t key) {
+    list.push_front(key);
+    ghosts[key] = {&list, list.begin()};
+}
+
+void ArcPolicy::forgetOldest(GhostList& list) {
+    ghosts.erase(list.back());
+    list.pop_back();
+}
+
+void ArcPolicy::onFault(uint64_t pageKey) {
+    pendingGhostHit = nullptr;
+    auto it = ghosts.find(pageKey);
+    if (it == ghosts.end()) {
+        return;
+    }
+
+    // A ghost hit means the list it came from was too small: grow its share
+    int b1Size = static_cast<int>(b1.size());
+    int b2Size = static_cast<int>(b2.size());
+    if (it->second.first == &b1) {
+        targetT1 = std::min(capacity, targetT1 + std::max(1, b2Size / b1Size));
+    } else {
+        targetT1 = std::max(0, targetT1 - std::max(1, b1Size / b2Size));
+    }
+    pendingGhostHit = it->second.first;
+    ghostHitsInFlight.insert(pageKey);
+    it->second.first->erase(it->second.second);
+    ghosts.erase(it);
+}
+
+void ArcPolicy::onFaultAbandoned(uint64_t pageKey) {
+    ghostHitsInFlight.erase(pageKey);
+}
+
+int ArcPolicy::selectVictim(const ReferenceProbe& /*testAndClearReferenced*/) {
+    int t1Size = static_cast<int>(t1.size());
+    if (!t1.empty() && (t1Size > targetT1 || (pendingGhostHit == &b2 && t1Size == targetT1) || t2.empty())) {
+        return t1.back();
+    }
+    return t2.back();
+}
+
+void ArcPolicy::onLoad(int frame, uint64_t pageKey) {
+    frameKeys[frame] = pageKey;
+    if (ghostHitsInFlight.erase(pageKey) > 0) {
+        t2.pushFront(frame);
+    } else {
+        t1.pushFront(frame);
+    }
+
+    // Keep |T1| + |B1| <= c and the whole directory <= 2c
+    while (t1.size() + b1.size() > static_cast<size_t>(capacity) && !b1.empty()) {
+        forgetOldest(b1);
+    }
+    while (t1.size() + t2.size() + b1.size() + b2.size() > static_cast<size_t>(2 * capacity) && !b2.empty()) {
+        forgetOldest(b2);
+    }
+}
+
+void ArcPolicy::onAccess(int frame) {
+    // Any hit promotes to (or refreshes within) the frequency list
+    if (t1.contains(frame)) {
+        t1.remove(frame);
+        t2.pushFront(frame);
+    } else if (t2.contains(frame) && t2.front() != frame) {
+        t2.remove(frame);
+        t2.pushFront(frame);
+    }
+}
+
+void ArcPolicy::onEvict(int frame) {
+    if (t1.contains(frame)) {
+        t1.remove(frame);
+        remember(b1, frameKeys[frame]);
+    } else if (t2.contains(frame)) {
+        t2.remove(frame);
+        remember(b2, frameKeys[frame]);
+    }
+}
+
+void ArcPolicy::onRelease(int frame) {
+    t1.remove(frame);
+    t2.remove(frame);
+}
@@ -0,0 +1,195 @@
+#ifndef REPLACEMENT_POLICY_H
+#define REPLACEMENT_POLICY_H
+
+#include <vector>
+#include <list>
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+// Intrusive doubly-linked list over frame numbers. Every frame owns one
+// prev/next slot, so push/remove/move are O(1) with no allocation.
+class FrameList {
+private:
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<uint8_t> linked;
+    int head = -1;      // Front (most recent insertion by pushFront)
+    int tail = -1;      // Back
+    size_t count = 0;
+
+public:
+    explicit FrameList(int totalFrames = 0);
+
+    void pushFront(int frame);
+    void pushBack(int frame);
+    void remove(int frame);
+    bool contains(int frame) const { return linked[frame] != 0; }
+    int front() const { return head; }
+    int back() const { return tail; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// Page replacement policy for the VirtualMemoryManager (page-replacement-alg).
+// The manager reports every residency change and hit by frame number and asks
+// for a victim only when no frame is free. Calls are serialized by the manager.
+class ReplacementPolicy {
+public:
+    // Returns the referenced bit of the page in a frame and clears it
+    using ReferenceProbe = std::function<bool(int frame)>;
+
+    virtual ~ReplacementPolicy() = default;
+
+    virtual const char* getName() const = 0;
+
+    // A fault on pageKey is about to be serviced (before any victim is chosen).
+    // Several faults may be in flight; each ends in onLoad or onFaultAbandoned.
+    virtual void onFault(uint64_t /*pageKey*/) {}
+    
+    // The fault on pageKey will not load (its process released its memory)
+    virtual void onFaultAbandoned(uint64_t /*pageKey*/) {}
+
+    // pageKey became resident in frame
+    virtual void onLoad(int frame, uint64_t pageKey) = 0;
+
+    // The page in frame was accessed while resident
+    virtual void onAccess(int frame) = 0;
+
+    // frame was chosen as a victim and its page is leaving memory
+    virtual void onEvict(int frame) { onRelease(frame); }
+
+    // frame was freed because its owner released its memory
+    virtual void onRelease(int frame) = 0;
+
+    // Frame to evict, or -1 if nothing is resident
+    virtual int selectVictim(const ReferenceProbe& testAndClearReferenced) = 0;
+
+    // Accepts LRU, FIFO, CLOCK, SECOND-CHANCE, LFU and ARC; unknown names fall back to LRU
+    static std::unique_ptr<ReplacementPolicy> create(const std::string& name, int totalFrames);
+};
+
+// Least recently used: hits move the frame to the front, the victim is the back
+class LruPolicy : public ReplacementPolicy {
+private:
+    FrameList recency;
+
+public:
+    explicit LruPolicy(int totalFrames) : recency(totalFrames) {}
+    const char* getName() const override { return "LRU"; }
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int frame) override;
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+// First in, first out: load order only, hits are ignored
+class FifoPolicy : public ReplacementPolicy {
+private:
+    FrameList arrival;
+
+public:
+    explicit FifoPolicy(int totalFrames) : arrival(totalFrames) {}
+    const char* getName() const override { return "FIFO"; }
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int /*frame*/) override {}
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+// Clock: a hand sweeps the frames in address order, clearing referenced bits
+// until it finds an unreferenced resident page
+class ClockPolicy : public ReplacementPolicy {
+private:
+    std::vector<uint8_t> resident;
+    size_t residentCount = 0;
+    int hand = 0;
+
+public:
+    explicit ClockPolicy(int totalFrames) : resident(totalFrames, 0) {}
+    const char* getName() const override { return "CLOCK"; }
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int /*frame*/) override {}
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+// Second chance: FIFO order, but a referenced page is cleared and requeued
+class SecondChancePolicy : public ReplacementPolicy {
+private:
+    FrameList arrival;
+
+public:
+    explicit SecondChancePolicy(int totalFrames) : arrival(totalFrames) {}
+    const char* getName() const override { return "SECOND-CHANCE"; }
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int /*frame*/) override {}
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+// Least frequently used, O(1): frames sit in per-frequency buckets and the
+// victim is the oldest frame of the lowest non-empty bucket
+class LfuPolicy : public ReplacementPolicy {
+private:
+    struct Bucket {
+        int head = -1;  // Most recently promoted
+        int tail = -1;  // Oldest, evicted first
+    };
+
+    std::vector<uint32_t> frequency;    // 0 when the frame is not resident
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::unordered_map<uint32_t, Bucket> buckets;
+    uint32_t minFrequency = 0;
+
+    void link(int frame);
+    void unlink(int frame);
+
+public:
+    explicit LfuPolicy(int totalFrames);
+    const char* getName() const override { return "LFU"; }
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int frame) override;
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+// Adaptive replacement cache (Megiddo and Modha). T1 holds pages seen once,
+// T2 pages seen at least twice; the ghost lists B1/B2 remember recently
+// evicted keys and steer the target size of T1 towards whichever list
+// would have avoided the miss.
+class ArcPolicy : public ReplacementPolicy {
+private:
+    using GhostList = std::list<uint64_t>;
+
+    int capacity;
+    int targetT1 = 0;               // p in the paper
+    FrameList t1;
+    FrameList t2;
+    std::vector<uint64_t> frameKeys;
+    GhostList b1;                   // Front is most recent
+    GhostList b2;
+    std::unordered_map<uint64_t, std::pair<GhostList*, GhostList::iterator>> ghosts;
+    GhostList* pendingGhostHit = nullptr;   // Ghost list of the fault now choosing a victim
+    std::unordered_set<uint64_t> ghostHitsInFlight;   // Faulting keys that go straight to T2
+
+    void remember(GhostList& list, uint64_t key);
+    void forgetOldest(GhostList& list);
+
+public:
+    explicit ArcPolicy(int totalFrames);
+    const char* getName() const override { return "ARC"; }
+    void onFault(uint64_t pageKey) override;
+    void onFaultAbandoned(uint64_t pageKey) override;
+    void onLoad(int frame, uint64_t pageKey) override;
+    void onAccess(int frame) override;
+    void onEvict(int frame) override;
+    void onRelease(int frame) override;
+    int selectVictim(const ReferenceProbe& testAndClearReferenced) override;
+};
+
+#endif
@@ -2,13 +2,25 @@
 #include "Process.h"
 #include "ProcessManager.h"
 #include "ConsoleManager.h"
+#include "InstructionDecoder.h"
 #include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <iostream>
 
-Scheduler::Scheduler(ProcessManager* pm) : running(false), generationStopped(false), activeProcesses(0), processManager(pm),
-    schedulerType(SchedulerType::FCFS), quantumCycles(5), numCores(1) {}
+Scheduler::Scheduler(ProcessManager* pm) : queuedProcesses(0), nextQueue(0),
+    running(false), generationStopped(false), halted(false), activeProcesses(0), completedProcesses(0), processManager(pm),
+    blockedProcesses(0),
+    schedulerType(SchedulerType::FCFS), quantumCycles(5), numCores(1), delayPerExec(0) {
+    resizeRunQueues(numCores);
+    
+    // Sleep timers are measured in clock ticks
+    clock.addTickListener([this](uint64_t) {
+        for (auto& process : sleepingProcesses.advance()) {
+            wakeProcess(std::move(process));
+        }
+    });
+}
 
 Scheduler::~Scheduler() {
     stop();
@@ -16,6 +28,13 @@ Scheduler::~Scheduler() {
 
 void Scheduler::start() {
     running = true;
+    halted = false;
+    
+    // Register every core before any of them can finish the first tick alone
+    for (int i = 0; i < numCores; ++i) {
+        clock.join();
+    }
+    pageFaultWorkers.start(IO_THREADS);
     for (int i = 0; i < numCores; ++i) {
         cpuThreads.emplace_back(&Scheduler::cpuWorker, this, i);
     }
@@ -24,13 +43,16 @@ void Scheduler::start() {
 void Scheduler::stop() {
     running = false;
     generationStopped = true;
-    cv.notify_all();
     for (auto& thread : cpuThreads) {
         if (thread.joinable()) {
             thread.join();
         }
     }
     cpuThreads.clear();
+    
+    // Cores only exit once no process is blocked, unless halted; either way
+    // every in-flight fault completes before the memory manager can go away
+    pageFaultWorkers.stop();
 }
 
 void Scheduler::stopGracefully() {
@@ -40,19 +62,49 @@ void Scheduler::stopGracefully() {
     // cpuWorker threads will continue until queue is empty
 }
 
+void Scheduler::halt() {
+    // Used by the simulator to end a run at an exact tick; unfinished processes stay where they are
+    halted = true;
+    stop();
+}
+
 void Scheduler::addProcess(std::shared_ptr<Process> process) {
     if (!process) {
         std::cerr << "Attempted to add null process to scheduler" << std::endl;
         return;
     }
     
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        readyQueue.push(process);
-        activeProcesses++;
-        // Removed verbose process addition logging
+    // New arrivals are spread round-robin across the core queues
+    int queueId = nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<int>(runQueues.size());
+    activeProcesses++;
+    pushToQueue(queueId, process);
+    // Removed verbose process addition logging
+}
+
+void Scheduler::addProcesses(const std::vector<std::shared_ptr<Process>>& batch) {
+    if (batch.empty()) {
+        return;
+    }
+    
+    // Placed exactly as if added one by one, but each core queue is locked
+    // once for its whole share of the batch
+    int queues = static_cast<int>(runQueues.size());
+    int count = static_cast<int>(batch.size());
+    int first = nextQueue.fetch_add(count, std::memory_order_relaxed) % queues;
+    activeProcesses += count;
+    
+    for (int share = 0; share < std::min(queues, count); ++share) {
+        CoreRunQueue& target = *runQueues[(first + share) % queues];
+        int added = 0;
+        std::lock_guard<std::mutex> lock(target.mutex);
+        for (int i = share; i < count; i += queues) {
+            batch[i]->setState(ProcessState::READY);
+            target.queue.push_back(batch[i]);
+            added++;
+        }
+        target.depth += added;
     }
-    cv.notify_one();
+    queuedProcesses += count;
 }
 
 bool Scheduler::isProcessing() const {
@@ -66,35 +118,275 @@ bool Scheduler::isRunning() const {
 void Scheduler::cpuWorker(int coreId) {
     // CPU worker thread running silently
     
-    // Continue running until the scheduler is stopped AND the queue is empty
-    while (running || !readyQueue.empty()) {
-        std::shared_ptr<Process> process = nullptr;
-        {
-            // Wait for a process to be available or for the scheduler to stop
-            std::unique_lock<std::mutex> lock(queueMutex);
-            
-            cv.wait(lock, [this]() { return !readyQueue.empty() || !running; });
-            
+    // Continue running until the scheduler is stopped AND all queues are empty
+    while (!halted) {
+        std::shared_ptr<Process> process = takeNextProcess(coreId);
+        
+        if (!process) {
             // Only exit if the scheduler is stopped AND there are no more processes to run
             // This allows existing processes to finish even after scheduler-stop is called
-            if (!running && readyQueue.empty()) {
-                return;
+            if (!running && queuedProcesses == 0 && sleepingProcesses.empty() && blockedProcesses == 0) {
+                break;
             }
             
-            // Get the next process from the ready queue
-            if (!readyQueue.empty()) {
-                process = readyQueue.front();
-                readyQueue.pop();
+            // An idle core still spends its tick so the others can advance
+            coreSlots[coreId].idleTicks.fetch_add(1, std::memory_order_relaxed);
+            clock.tick();
+            continue;
+        }
+        
+        executeProcess(process, coreId);
+    }
+    
+    clock.leave();
+}
+
+int Scheduler::executeCycle(std::shared_ptr<Process> process, int coreId) {
+    CoreSlot& slot = coreSlots[coreId];
+    
+    // One instruction per tick, then delay-per-exec more ticks holding the core
+    executeInstruction(process, process->getCurrentDecodedInstruction());
+    
+    // A faulting instruction still costs its tick but is not retired
+    bool retired = process->getState() != ProcessState::BLOCKED_IO;
+    if (retired) {
+        process->advanceInstruction();
+    }
+    
+    int ticks = 1 + delayPerExec;
+    for (int i = 0; i < ticks; ++i) {
+        clock.tick();
+    }
+    process->addCpuTicks(ticks);
+    
+    // Ticks are published first, so a reader never sees more instructions than busy ticks
+    slot.busyTicks.fetch_add(ticks, std::memory_order_relaxed);
+    if (retired) {
+        slot.instructionsRetired.fetch_add(1, std::memory_order_release);
+    }
+    
+    if (!process->getIsActive()) {
+        process->setFinishTick(clock.now());
+        completedProcesses++;
+        if (processManager) {
+            processManager->onProcessFinished(process);
+        }
+    }
+    return ticks;
+}
+
+std::shared_ptr<Process> Scheduler::takeNextProcess(int coreId) {
+    CoreRunQueue& own = *runQueues[coreId];
+    if (own.depth > 0) {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.queue.empty()) {
+            std::shared_ptr<Process> process = std::move(own.queue.front());
+            own.queue.pop_front();
+            own.depth--;
+            queuedProcesses--;
+            return process;
+        }
+    }
+    
+    // Own queue drained, take work from a sibling
+    return stealProcess(coreId);
+}
+
+std::shared_ptr<Process> Scheduler::stealProcess(int coreId) {
+    int queueCount = static_cast<int>(runQueues.size());
+    
+    // Steal from the deepest sibling, scanning depths without taking any locks
+    while (queuedProcesses > 0) {
+        int victim = -1;
+        int victimDepth = 0;
+        for (int i = 1; i < queueCount; ++i) {
+            int candidate = (coreId + i) % queueCount;
+            int depth = runQueues[candidate]->depth;
+            if (depth > victimDepth) {
+                victim = candidate;
+                victimDepth = depth;
             }
         }
+        if (victim == -1) {
+            return nullptr;
+        }
         
-        // Execute the process
-        if (process) {
-            executeProcess(process, coreId);
+        CoreRunQueue& sibling = *runQueues[victim];
+        std::lock_guard<std::mutex> lock(sibling.mutex);
+        if (!sibling.queue.empty()) {
+            std::shared_ptr<Process> process = std::move(sibling.queue.front());
+            sibling.queue.pop_front();
+            sibling.depth--;
+            queuedProcesses--;
+            runQueues[coreId]->steals++;
+            return process;
+        }
+        // Lost the race for that queue, rescan
+    }
+    
+    return nullptr;
+}
+
+void Scheduler::pushToQueue(int queueId, std::shared_ptr<Process> process) {
+    CoreRunQueue& target = *runQueues[queueId];
+    process->setState(ProcessState::READY);
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.queue.push_back(std::move(process));
+        target.depth++;
+    }
+    queuedProcesses++;
+}
+
+void Scheduler::resizeRunQueues(int cores) {
+    // Collect anything still queued so it survives the resize
+    std::vector<std::shared_ptr<Process>> pending;
+    for (auto& runQueue : runQueues) {
+        std::lock_guard<std::mutex> lock(runQueue->mutex);
+        for (auto& process : runQueue->queue) {
+            pending.push_back(std::move(process));
+        }
+    }
+    
+    runQueues.clear();
+    for (int i = 0; i < cores; ++i) {
+        runQueues.push_back(std::make_unique<CoreRunQueue>());
+    }
+    coreSlots = std::make_unique<CoreSlot[]>(cores);
+    coreSlotCount = cores;
+    queuedProcesses = 0;
+    
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pushToQueue(static_cast<int>(i % runQueues.size()), std::move(pending[i]));
+    }
+}
+
+uint64_t Scheduler::getStealCount() const {
+    uint64_t steals = 0;
+    for (const auto& runQueue : runQueues) {
+        steals += runQueue->steals;
+    }
+    return steals;
+}
+
+std::vector<int> Scheduler::getQueueDepths() const {
+    std::vector<int> depths;
+    depths.reserve(runQueues.size());
+    for (const auto& runQueue : runQueues) {
+        depths.push_back(runQueue->depth);
+    }
+    return depths;
+}
+
+std::vector<CoreOccupancy> Scheduler::getCoreOccupancy() const {
+    std::vector<CoreOccupancy> occupancy;
+    occupancy.reserve(coreSlotCount);
+    for (int i = 0; i < coreSlotCount; ++i) {
+        occupancy.push_back({coreSlots[i].processId.load(std::memory_order_relaxed),
+                             coreSlots[i].busySince.load(std::memory_order_relaxed)});
+    }
+    return occupancy;
+}
+
+int Scheduler::getProcessCore(int processId) const {
+    for (int i = 0; i < coreSlotCount; ++i) {
+        if (coreSlots[i].processId.load(std::memory_order_relaxed) == processId) {
+            return i;
         }
     }
+    return -1;
+}
+
+int Scheduler::getBusyCoreCount() const {
+    int busy = 0;
+    for (int i = 0; i < coreSlotCount; ++i) {
+        if (coreSlots[i].processId.load(std::memory_order_relaxed) != -1) {
+            ++busy;
+        }
+    }
+    return busy;
+}
+
+CpuTickCounts Scheduler::getCpuTickCounts() const {
+    CpuTickCounts counts;
+    for (int i = 0; i < coreSlotCount; ++i) {
+        counts.instructionsRetired += coreSlots[i].instructionsRetired.load(std::memory_order_acquire);
+        counts.busyTicks += coreSlots[i].busyTicks.load(std::memory_order_relaxed);
+        counts.idleTicks += coreSlots[i].idleTicks.load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+int Scheduler::getQueuedProcessCount() const {
+    return queuedProcesses;
+}
+
+size_t Scheduler::getSleepingProcessCount() const {
+    return sleepingProcesses.size();
+}
+
+int Scheduler::getBlockedProcessCount() const {
+    return blockedProcesses;
+}
+
+uint64_t Scheduler::getCompletedProcessCount() const {
+    return completedProcesses;
+}
+
+bool Scheduler::parkIfSleeping(std::shared_ptr<Process> process) {
+    // A SLEEP as the last instruction just finishes the process
+    if (process->getState() != ProcessState::SLEEPING || !process->getIsActive()) {
+        return false;
+    }
+    
+    // Give up the core before the process becomes visible to the clock listener
+    releaseCore(process);
+    sleepingProcesses.schedule(process, process->getSleepTicks());
+    return true;
+}
+
+bool Scheduler::parkIfBlocked(std::shared_ptr<Process> process) {
+    if (process->getState() != ProcessState::BLOCKED_IO) {
+        return false;
+    }
+    
+    // The core moves on to other work while an I/O thread brings the page in
+    releaseCore(process);
+    blockedProcesses++;
+    pageFaultWorkers.submit([this, process]() {
+        try {
+            processManager->servicePageFault(process->getProcessId(), process->getFaultAddress());
+        } catch (const std::exception& e) {
+            std::cerr << "Page fault error: " << e.what() << std::endl;
+        }
+        // Re-queued either way; a failed fault is retried when the instruction reruns
+        wakeProcess(process);
+        blockedProcesses--;
+    });
+    return true;
 }
 
+void Scheduler::wakeProcess(std::shared_ptr<Process> process) {
+    // Woken processes are spread like new arrivals; they are still counted as active
+    int queueId = nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<int>(runQueues.size());
+    pushToQueue(queueId, std::move(process));
+}
+
+void Scheduler::claimCore(const std::shared_ptr<Process>& process, int coreId) {
+    process->setAssignedCore(coreId);
+    CoreSlot& slot = coreSlots[coreId];
+    slot.busySince.store(clock.now(), std::memory_order_relaxed);
+    slot.processId.store(process->getProcessId(), std::memory_order_relaxed);
+}
+
+void Scheduler::releaseCore(std::shared_ptr<Process> process) {
+    // Only the worker that claimed the core releases it, so this is the only writer
+    int coreId = process->getAssignedCore();
+    process->setAssignedCore(-1);
+    if (coreId >= 0 && coreId < coreSlotCount) {
+        coreSlots[coreId].processId.store(-1, std::memory_order_relaxed);
+    }
+}
 
 void Scheduler::executeProcess(std::shared_ptr<Process> process, int coreId) {
     if (!process) {
@@ -103,9 +395,8 @@ void Scheduler::executeProcess(std::shared_ptr<Process> process, int coreId) {
     }
     
     try {
-        if (processManager) {
-            processManager->updateProcessCore(process->getProcessId(), coreId);
-        }
+        process->setState(ProcessState::RUNNING);
+        claimCore(process, coreId);
         
         // Removed scheduler logging
                 
@@ -116,30 +407,36 @@ void Scheduler::executeProcess(std::shared_ptr<Process> process, int coreId) {
         }
     } catch (const std::exception& e) {
         std::cerr << "Exception in executeProcess: " << e.what() << std::endl;
+        // Unless it was already handed on, the process gives the core back
+        if (process->getAssignedCore() == coreId) {
+            releaseCore(process);
+        }
     }
-    
-    activeProcesses--;
 }
 
 void Scheduler::executeProcessFCFS(std::shared_ptr<Process> process, int coreId) {
     if (process->isAutoExecuting()) {
-        while (process->hasMoreInstructions() && process->getIsActive()) {
-            std::string currentInstruction = process->getCurrentInstruction();
-            
-            executeInstruction(process, currentInstruction);
-            
-            process->addToExecutionLog(currentInstruction);
-            
-            process->advanceInstruction();
+        while (process->hasMoreInstructions() && process->getIsActive() && !halted) {
+            executeCycle(process, coreId);
             
-            // std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            // A sleeping or faulting process gives up the core and resumes from the ready queue
+            if (parkIfSleeping(process) || parkIfBlocked(process)) {
+                return;
+            }
         }
     }
 
     // If the process has finished all instructions, mark it as finished
     if (!process->getIsActive()) {
+        if (processManager) {
+            processManager->releaseProcessMemory(process);
+        }
+        releaseCore(process);
         activeProcesses--;  // Reduce the active process count
         // Process has finished executing
+    } else {
+        // Halted mid-run: the process stays unfinished but no longer holds the core
+        releaseCore(process);
     }
 }
 
@@ -150,17 +447,15 @@ void Scheduler::executeProcessRR(std::shared_ptr<Process> process, int coreId) {
     if (process->isAutoExecuting()) {
         int cyclesExecuted = 0;
         
-        // Execute up to the quantum limit
-        while (process->hasMoreInstructions() && process->getIsActive() && cyclesExecuted < quantumCycles) {
-            std::string currentInstruction = process->getCurrentInstruction();
-            
+        // Execute until the quantum's ticks are used up
+        while (process->hasMoreInstructions() && process->getIsActive() && cyclesExecuted < quantumCycles && !halted) {
             // Removed instruction execution log
-            executeInstruction(process, currentInstruction);
+            cyclesExecuted += executeCycle(process, coreId);
             
-            process->addToExecutionLog(currentInstruction);
-            process->advanceInstruction();
-            
-            cyclesExecuted++;
+            // SLEEP and page faults end the quantum early
+            if (process->getState() == ProcessState::SLEEPING || process->getState() == ProcessState::BLOCKED_IO) {
+                break;
+            }
         }
         
         // Removed instruction execution summary log
@@ -171,7 +466,7 @@ void Scheduler::executeProcessRR(std::shared_ptr<Process> process, int coreId) {
             if (processManager) {
                 processManager->releaseProcessMemory(process);
             }
-            process->setAssignedCore(-1);
+            releaseCore(process);
             
             // Generate memory snapshot at the end of quantum cycle
             if (processManager) {
@@ -190,223 +485,123 @@ void Scheduler::executeProcessRR(std::shared_ptr<Process> process, int coreId) {
             processManager->incrementQuantumCycle();
         }
         
+        // A sleeping process waits in the timer wheel, a faulting one on the I/O pool
+        if (parkIfSleeping(process) || parkIfBlocked(process)) {
+            return;
+        }
+        
         // If the process has more instructions, add it back to the ready queue
         if (process->hasMoreInstructions() && process->getIsActive()) {
             // Process has more work, adding back to ready queue
-            std::lock_guard<std::mutex> lock(queueMutex);
-            process->setAssignedCore(-1);
-            readyQueue.push(process);
+            releaseCore(process);
+            requeueProcess(process, coreId);
         }
     } else {
         // Manual execution mode
         if (process->hasMoreInstructions() && process->getIsActive()) {
-            std::string currentInstruction = process->getCurrentInstruction();
-            
-            executeInstruction(process, currentInstruction);
-            
-            process->addToExecutionLog(currentInstruction);
-            process->advanceInstruction();
+            executeCycle(process, coreId);
             
             // If the process is finished, release its memory
             if (!process->hasMoreInstructions() || !process->getIsActive()) {
                 if (processManager) {
                     processManager->releaseProcessMemory(process);
                 }
-                process->setAssignedCore(-1);
+                releaseCore(process);
                 
                 // Generate memory snapshot at the end of quantum cycle
                 if (processManager) {
                     processManager->incrementQuantumCycle();
                 }
             } else {
-                // If the process has more instructions, add it back to the ready queue
-                std::lock_guard<std::mutex> lock(queueMutex);
-                process->setAssignedCore(-1);
-                readyQueue.push(process);
-                
                 // Generate memory snapshot at the end of quantum cycle
                 if (processManager) {
                     processManager->incrementQuantumCycle();
                 }
+                
+                // If the process has more instructions, add it back to the ready queue,
+                // or to the timer wheel if it is sleeping, or the I/O pool if it faulted
+                if (!parkIfSleeping(process) && !parkIfBlocked(process)) {
+                    releaseCore(process);
+                    requeueProcess(process, coreId);
+                }
             }
         }
     }
 }
 
 
-void Scheduler::executeInstruction(std::shared_ptr<Process> process, const std::string& instruction) {
-    // Parse and execute the instruction
-    if (instruction.find("PRINT(") == 0) {
-        size_t start = instruction.find('(') + 1;
-        size_t end = instruction.find(')', start);
-        if (end != std::string::npos) {
-            std::string content = instruction.substr(start, end - start);
-    
-            // Split by '+'
-            std::stringstream ss(content);
-            std::string segment;
-            bool first = true;
-            while (std::getline(ss, segment, '+')) {
-                // Trim whitespace
-                segment.erase(0, segment.find_first_not_of(" \t"));
-                segment.erase(segment.find_last_not_of(" \t") + 1);
-    
-                // If quoted string
-                if (!segment.empty() && segment.front() == '"' && segment.back() == '"') {
-                    std::cout << segment.substr(1, segment.size() - 2);
-                } else if (!segment.empty()) {
+void Scheduler::executeInstruction(std::shared_ptr<Process> process, const DecodedInstruction& instruction) {
+    // Dispatch on the instruction decoded in Process::setInstructions
+    switch (instruction.op) {
+        case OpCode::PRINT: {
+            const DecodedProgram& program = process->getProgram();
+            for (uint32_t i = 0; i < instruction.auxCount; ++i) {
+                const PrintSegment& segment = program.printSegments[instruction.aux + i];
+                if (segment.isLiteral) {
+                    std::cout << program.literals[segment.index];
+                } else {
                     // Variable: print its value
-                    process->ensureVariableExists(segment);
-                    std::cout << process->getVariable(segment);
+                    std::cout << process->getSymbolValue(static_cast<uint16_t>(segment.index));
                 }
             }
             std::cout << std::endl;
+            break;
         }
-    }
-    else if (instruction.find("DECLARE(") == 0) {
-        // Parse DECLARE(var, value)
-        size_t start = instruction.find('(') + 1;
-        size_t end = instruction.find(')', start);
-        if (end != std::string::npos) {
-            std::string params = instruction.substr(start, end - start);
-            size_t commaPos = params.find(',');
-            if (commaPos != std::string::npos) {
-                std::string varName = params.substr(0, commaPos);
-                std::string valueStr = params.substr(commaPos + 1);
-                
-                // Trim whitespace
-                varName.erase(0, varName.find_first_not_of(" \t"));
-                varName.erase(varName.find_last_not_of(" \t") + 1);
-                valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                
-                try {
-                    uint16_t value = static_cast<uint16_t>(std::stoi(valueStr));
-                    process->setVariable(varName, value);
-                } catch (...) {
-                    // Invalid value, set to 0
-                    process->setVariable(varName, 0);
-                }
-            }
-        }
-    }
-    else if (instruction.find("ADD(") == 0) {
-        // Parse ADD(target, source1, source2)
-        executeArithmeticInstruction(process, instruction, "ADD");
-    }
-    else if (instruction.find("SUBTRACT(") == 0) {
-        // Parse SUBTRACT(target, source1, source2)
-        executeArithmeticInstruction(process, instruction, "SUBTRACT");
-    }
-    else if (instruction.find("SLEEP(") == 0) {
-        // Parse SLEEP(ticks)
-        size_t start = instruction.find('(') + 1;
-        size_t end = instruction.find(')', start);
-        if (end != std::string::npos) {
-            std::string ticksStr = instruction.substr(start, end - start);
-            try {
-                int ticks = std::stoi(ticksStr);
-                if (ticks > 0) {
-                    // Sleep for ticks * 100ms (simulating CPU ticks)
-                    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * 100));
-                }
-            } catch (...) {
-                // Invalid ticks, ignore
-            }
+        case OpCode::DECLARE:
+            process->setSymbolValue(instruction.args[0].value, instruction.args[1].value);
+            break;
+        case OpCode::ADD: {
+            uint32_t temp = static_cast<uint32_t>(readOperand(process, instruction.args[1])) +
+                            static_cast<uint32_t>(readOperand(process, instruction.args[2]));
+            process->setSymbolValue(instruction.args[0].value, (temp > 65535) ? 65535 : static_cast<uint16_t>(temp));
+            break;
         }
-    }
-    else if (instruction.find("FOR(") == 0) {
-        // TODO: Implement nested instruction execution
-    }
-    else if (instruction.find("READ(") == 0) {
-        // Parse READ(var, address) - Phase 2 instruction
-        executeMemoryInstruction(process, instruction, "READ");
-    }
-    else if (instruction.find("WRITE(") == 0) {
-        // Parse WRITE(address, value) - Phase 2 instruction
-        executeMemoryInstruction(process, instruction, "WRITE");
-    }
-}
-
-void Scheduler::executeArithmeticInstruction(std::shared_ptr<Process> process, const std::string& instruction, const std::string& operation) {
-    // Parse operation(target, source1, source2)
-    size_t start = instruction.find('(') + 1;
-    size_t end = instruction.find(')', start);
-    if (end == std::string::npos) return;
-    
-    std::string params = instruction.substr(start, end - start);
-    std::vector<std::string> args;
-    
-    // Split by comma
-    size_t pos = 0;
-    while (pos < params.length() && args.size() < 3) {
-        size_t commaPos = params.find(',', pos);
-        if (commaPos == std::string::npos) {
-            args.push_back(params.substr(pos));
+        case OpCode::SUBTRACT: {
+            uint16_t val1 = readOperand(process, instruction.args[1]);
+            uint16_t val2 = readOperand(process, instruction.args[2]);
+            process->setSymbolValue(instruction.args[0].value, (val1 >= val2) ? (val1 - val2) : 0);
             break;
-        } else {
-            args.push_back(params.substr(pos, commaPos - pos));
-            pos = commaPos + 1;
         }
+        case OpCode::SLEEP:
+            // The core is released after this instruction and the process parked for aux ticks
+            process->sleepFor(instruction.aux);
+            break;
+        case OpCode::FOR_BEGIN:
+        case OpCode::FOR_END:
+            // Loop control is stepped over by Process::advanceInstruction
+            break;
+        case OpCode::READ:
+        case OpCode::WRITE:
+            // Phase 2 instructions
+            executeMemoryInstruction(process, instruction);
+            break;
+        case OpCode::NOP:
+            break;
     }
-    
-    if (args.size() != 3) return;
-    
-    // Trim whitespace from all arguments
-    for (auto& arg : args) {
-        arg.erase(0, arg.find_first_not_of(" \t"));
-        arg.erase(arg.find_last_not_of(" \t") + 1);
-    }
-    
-    std::string target = args[0];
-    
-    // Get values for source1 and source2
-    uint16_t val1 = getValueFromArgument(process, args[1]);
-    uint16_t val2 = getValueFromArgument(process, args[2]);
-    
-    // Perform operation
-    uint16_t result;
-    if (operation == "ADD") {
-        uint32_t temp = static_cast<uint32_t>(val1) + static_cast<uint32_t>(val2);
-        result = (temp > 65535) ? 65535 : static_cast<uint16_t>(temp);
-    } else if (operation == "SUBTRACT") {
-        result = (val1 >= val2) ? (val1 - val2) : 0;
-    } else {
-        result = 0;
-    }
-    
-    // Store result
-    process->setVariable(target, result);
 }
 
-uint16_t Scheduler::getValueFromArgument(std::shared_ptr<Process> process, const std::string& arg) {
-    // Check if argument is a number or variable
-    if (std::all_of(arg.begin(), arg.end(), ::isdigit)) {
-        try {
-            int value = std::stoi(arg);
-            return (value < 0) ? 0 : (value > 65535) ? 65535 : static_cast<uint16_t>(value);
-        } catch (...) {
-            return 0;
-        }
-    } else {
-        // It's a variable
-        process->ensureVariableExists(arg);
-        return process->getVariable(arg);
+uint16_t Scheduler::readOperand(std::shared_ptr<Process> process, const Operand& operand) {
+    if (operand.kind == OperandKind::VARIABLE) {
+        return process->getSymbolValue(operand.value);
     }
+    return operand.value;
 }
 
 // Configuration methods
-void Scheduler::setSchedulerConfig(const std::string& algorithm, int quantum, int cores) {
+void Scheduler::setSchedulerConfig(const std::string& algorithm, int quantum, int cores, int delay) {
     schedulerType = parseSchedulerType(algorithm);
     quantumCycles = quantum;
+    delayPerExec = (delay > 0) ? delay : 0;
     
     // If numCores is changing and scheduler is running, restart with new core count
     if (numCores != cores && running) {
         stop();
         numCores = cores;
+        resizeRunQueues(cores);
         start();
-    } else {
+    } else if (numCores != cores) {
         numCores = cores;
+        resizeRunQueues(cores);
     }
 }
 
@@ -417,54 +612,55 @@ SchedulerType Scheduler::parseSchedulerType(const std::string& algorithm) {
     return SchedulerType::FCFS; // Default to FCFS
 }
 
-void Scheduler::requeueProcess(std::shared_ptr<Process> process) {
-    {
-        // Ensure thread safety when accessing the queue
-        std::lock_guard<std::mutex> lock(queueMutex);
-        
-        if (process->getIsActive()) {  // Only requeue active processes
-            readyQueue.push(process);
+void Scheduler::requeueProcess(std::shared_ptr<Process> process, int coreId) {
+    if (!process->getIsActive()) {  // Only requeue active processes
+        return;
+    }
+    
+    // Preempted processes go back on this core's queue, unless it is already
+    // holding more than its share, in which case the shallowest queue gets it
+    int queueCount = static_cast<int>(runQueues.size());
+    int average = queuedProcesses / queueCount;
+    int target = coreId;
+    if (runQueues[coreId]->depth > average + MAX_QUEUE_SKEW) {
+        for (int i = 0; i < queueCount; ++i) {
+            if (runQueues[i]->depth < runQueues[target]->depth) {
+                target = i;
+            }
         }
     }
-    cv.notify_one();  // Notify worker thread to pick up a process
+    
+    pushToQueue(target, process);
 }
 
 // Phase 2: Memory instruction execution
-void Scheduler::executeMemoryInstruction(std::shared_ptr<Process> process, const std::string& instruction, const std::string& operation) {
+void Scheduler::executeMemoryInstruction(std::shared_ptr<Process> process, const DecodedInstruction& instruction) {
     try {
-        if (operation == "READ") {
-            // Parse READ(var, address)
-            auto args = parseInstructionArgs(instruction);
-            if (args.size() < 2) {
-                std::cerr << "Invalid READ instruction format: " << instruction << std::endl;
+        if (instruction.op == OpCode::READ) {
+            // READ(var, address) - a page fault blocks the process until the page is in
+            uint32_t address = instruction.aux;
+            uint16_t value = 0;
+            if (!processManager->tryReadProcessMemory(process->getProcessId(), address, value, process->getAssignedCore())) {
+                process->blockOnPageFault(address);
                 return;
             }
+            process->setSymbolValue(instruction.args[0].value, value);
             
-            std::string varName = args[0];
-            uint32_t address = parseHexAddress(args[1]);
-            
-            // Read from virtual memory (may trigger page fault)
-            uint16_t value = processManager->readProcessMemory(process->getProcessId(), address);
-            process->setVariable(varName, value);
-            
+            uint16_t slot = instruction.args[0].value;
             std::cout << "READ: Process " << process->getProcessId() 
                       << " read value " << value << " from address 0x" 
-                      << std::hex << address << std::dec << " into variable " << varName << std::endl;
+                      << std::hex << address << std::dec << " into variable " 
+                      << (slot == NO_SYMBOL ? "(symbol table full)" : process->getProgram().symbols[slot]) << std::endl;
         }
-        else if (operation == "WRITE") {
-            // Parse WRITE(address, value)
-            auto args = parseInstructionArgs(instruction);
-            if (args.size() < 2) {
-                std::cerr << "Invalid WRITE instruction format: " << instruction << std::endl;
+        else if (instruction.op == OpCode::WRITE) {
+            // WRITE(address, value) - a page fault blocks the process until the page is in
+            uint32_t address = instruction.aux;
+            uint16_t value = readOperand(process, instruction.args[1]);
+            if (!processManager->tryWriteProcessMemory(process->getProcessId(), address, value, process->getAssignedCore())) {
+                process->blockOnPageFault(address);
                 return;
             }
             
-            uint32_t address = parseHexAddress(args[0]);
-            uint16_t value = getValueFromArgument(process, args[1]);
-            
-            // Write to virtual memory (may trigger page fault)
-            processManager->writeProcessMemory(process->getProcessId(), address, value);
-            
             std::cout << "WRITE: Process " << process->getProcessId() 
                       << " wrote value " << value << " to address 0x" 
                       << std::hex << address << std::dec << std::endl;
@@ -473,59 +669,3 @@ void Scheduler::executeMemoryInstruction(std::shared_ptr<Process> process, const
         std::cerr << "Memory instruction error: " << e.what() << std::endl;
     }
 }
-
-// Helper method to parse hexadecimal addresses
-uint32_t Scheduler::parseHexAddress(const std::string& addressStr) {
-    std::string trimmed = addressStr;
-    
-    // Trim whitespace
-    trimmed.erase(0, trimmed.find_first_not_of(" \t"));
-    trimmed.erase(trimmed.find_last_not_of(" \t") + 1);
-    
-    // Handle hex prefix
-    if (trimmed.find("0x") == 0 || trimmed.find("0X") == 0) {
-        return std::stoul(trimmed, nullptr, 16);
-    } else {
-        // Assume decimal if no hex prefix
-        return std::stoul(trimmed, nullptr, 10);
-    }
-}
-
-// Helper method to parse instruction arguments
-std::vector<std::string> Scheduler::parseInstructionArgs(const std::string& instruction) {
-    std::vector<std::string> args;
-    
-    size_t start = instruction.find('(') + 1;
-    size_t end = instruction.find(')', start);
-    
-    if (end == std::string::npos) {
-        return args; // Invalid format
-    }
-    
-    std::string params = instruction.substr(start, end - start);
-    
-    // Split by comma
-    size_t pos = 0;
-    while (pos < params.length()) {
-        size_t commaPos = params.find(',', pos);
-        std::string arg;
-        
-        if (commaPos == std::string::npos) {
-            arg = params.substr(pos);
-            pos = params.length();
-        } else {
-            arg = params.substr(pos, commaPos - pos);
-            pos = commaPos + 1;
-        }
-        
-        // Trim whitespace
-        arg.erase(0, arg.find_first_not_of(" \t"));
-        arg.erase(arg.find_last_not_of(" \t") + 1);
-        
-        if (!arg.empty()) {
-            args.push_back(arg);
-        }
-    }
-    
-    return args;
-}
@@ -1,41 +1,102 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <vector>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include "TimerWheel.h"
+#include "CpuClock.h"
+#include "IoWorkerPool.h"
 
 // Forward declaration to avoid circular dependency
 class Process;
 class ProcessManager;
+struct DecodedInstruction;
+struct Operand;
 
 enum class SchedulerType {
     FCFS,  // First Come First Served
     RR     // Round Robin
 };
 
+// Ready queue owned by one core. The owner pops from the front, and idle
+// siblings steal from the front too so arrival order is preserved.
+struct CoreRunQueue {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Process>> queue;
+    std::atomic<int> depth{0};          // Mirrors queue.size() for lock-free load checks
+    std::atomic<uint64_t> steals{0};    // Processes this core took from siblings
+};
+
+// What one core is running and what it has done so far. Written only by
+// that core's worker, read lock-free by the stats paths; a cache line each
+// so cores never share one.
+struct alignas(64) CoreSlot {
+    std::atomic<int> processId{-1};         // -1 while the core is idle
+    std::atomic<uint64_t> busySince{0};     // Clock tick the process took the core
+    std::atomic<uint64_t> busyTicks{0};     // Ticks spent executing, including delay-per-exec
+    std::atomic<uint64_t> idleTicks{0};     // Ticks spent with nothing to run
+    std::atomic<uint64_t> instructionsRetired{0};
+};
+
+// Tick accounting summed over all cores
+struct CpuTickCounts {
+    uint64_t busyTicks = 0;
+    uint64_t idleTicks = 0;
+    uint64_t instructionsRetired = 0;
+};
+
+// Snapshot of one core's slot
+struct CoreOccupancy {
+    int processId;
+    uint64_t busySince;
+};
+
 class Scheduler {
 private:
+    // Max number of processes a core's queue may hold above the global average
+    // before a round-robin requeue is sent to the shallowest queue instead
+    static constexpr int MAX_QUEUE_SKEW = 2;
+    
+    // Threads servicing page faults for processes blocked on I/O
+    static constexpr int IO_THREADS = 2;
+    
     // NUM_CORES removed - use dynamic numCores from config
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    std::vector<std::unique_ptr<CoreRunQueue>> runQueues;
+    std::unique_ptr<CoreSlot[]> coreSlots;  // Indexed by core, sized with the run queues
+    int coreSlotCount = 0;
     std::vector<std::thread> cpuThreads;
-    std::mutex queueMutex;
-    std::condition_variable cv;
+    std::atomic<int> queuedProcesses;   // Total across all run queues
+    std::atomic<int> nextQueue;         // Round-robin placement of new arrivals
     std::atomic<bool> running;
     std::atomic<bool> generationStopped; // For graceful shutdown - stop generation but allow execution
+    std::atomic<bool> halted;           // Cores abandon their work at the next tick
     std::atomic<int> activeProcesses;
+    std::atomic<uint64_t> completedProcesses;
     ProcessManager* processManager;
     
+    // All cores advance this clock in lock-step, one tick per executed instruction
+    CpuClock clock;
+    
+    // Sleeping processes wait here instead of holding a core, advanced by a clock listener
+    TimerWheel sleepingProcesses;
+    
+    // Faulting processes give up their core; the page is read in here and the
+    // process re-queued. Declared after the run queues so it stops first.
+    IoWorkerPool pageFaultWorkers;
+    std::atomic<int> blockedProcesses;
+    
     // Scheduling configuration
     SchedulerType schedulerType;
-    int quantumCycles;
+    int quantumCycles;      // Ticks a process may run before round-robin preemption
     int numCores;
+    int delayPerExec;       // Extra ticks each instruction holds its core
 
 public:
     Scheduler(ProcessManager* pm);
@@ -44,28 +105,56 @@ public:
     void start();
     void stop();
     void stopGracefully(); // Allow current processes to finish
+    void halt();           // Stop all cores without finishing queued work
     void addProcess(std::shared_ptr<Process> process);
+    void addProcesses(const std::vector<std::shared_ptr<Process>>& batch);
     bool isProcessing() const;
     bool isRunning() const;
     
     // Configuration methods
-    void setSchedulerConfig(const std::string& algorithm, int quantum, int cores);
+    void setSchedulerConfig(const std::string& algorithm, int quantum, int cores, int delay = 0);
+    CpuClock& getClock() { return clock; }
+    
+    // Run queue statistics
+    uint64_t getStealCount() const;
+    std::vector<int> getQueueDepths() const;
+    int getQueuedProcessCount() const;
+    size_t getSleepingProcessCount() const;
+    int getBlockedProcessCount() const;
+    uint64_t getCompletedProcessCount() const;
+    
+    // Core occupancy, O(cores) and lock-free
+    std::vector<CoreOccupancy> getCoreOccupancy() const;
+    int getProcessCore(int processId) const;    // -1 when not on a core
+    int getBusyCoreCount() const;
+    CpuTickCounts getCpuTickCounts() const;
     
 private:
     void cpuWorker(int coreId);
+    int executeCycle(std::shared_ptr<Process> process, int coreId);
     void executeProcess(std::shared_ptr<Process> process, int coreId);
     void executeProcessFCFS(std::shared_ptr<Process> process, int coreId);
     void executeProcessRR(std::shared_ptr<Process> process, int coreId);
-    void executeInstruction(std::shared_ptr<Process> process, const std::string& instruction);
-    void executeArithmeticInstruction(std::shared_ptr<Process> process, const std::string& instruction, const std::string& operation);
-    void executeMemoryInstruction(std::shared_ptr<Process> process, const std::string& instruction, const std::string& operation);
-    uint16_t getValueFromArgument(std::shared_ptr<Process> process, const std::string& arg);
-    uint32_t parseHexAddress(const std::string& addressStr);
-    std::vector<std::string> parseInstructionArgs(const std::string& instruction);
+    void executeInstruction(std::shared_ptr<Process> process, const DecodedInstruction& instruction);
+    void executeMemoryInstruction(std::shared_ptr<Process> process, const DecodedInstruction& instruction);
+    uint16_t readOperand(std::shared_ptr<Process> process, const Operand& operand);
+    
+    // Run queue helpers
+    std::shared_ptr<Process> takeNextProcess(int coreId);
+    std::shared_ptr<Process> stealProcess(int coreId);
+    void pushToQueue(int queueId, std::shared_ptr<Process> process);
+    void resizeRunQueues(int cores);
+    
+    // Sleep and wake helpers
+    bool parkIfSleeping(std::shared_ptr<Process> process);
+    bool parkIfBlocked(std::shared_ptr<Process> process);
+    void wakeProcess(std::shared_ptr<Process> process);
+    void claimCore(const std::shared_ptr<Process>& process, int coreId);
+    void releaseCore(std::shared_ptr<Process> process);
     
     // Helper methods
     SchedulerType parseSchedulerType(const std::string& algorithm);
-    void requeueProcess(std::shared_ptr<Process> process);
+    void requeueProcess(std::shared_ptr<Process> process, int coreId);
 };
 
 #endif
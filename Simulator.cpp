@@ -0,0 +1,159 @@
+#include "Simulator.h"
+#include "ProcessManager.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Discards everything written to it; stands in for stdout while the simulation runs
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+}
+
+Simulator::Simulator(const Config& config, uint64_t ticks) : config(config), totalTicks(ticks) {
+    samples.reserve(SAMPLE_COUNT + 1);
+}
+
+int Simulator::run() {
+    // Virtual time: ticks advance as fast as the cores can execute them
+    config.cpuTickMs = 0;
+
+    // Instruction output would dominate the run time, so stdout is discarded until the report
+    NullBuffer nullBuffer;
+    std::streambuf* originalBuffer = std::cout.rdbuf(&nullBuffer);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    ProcessManager manager;
+    try {
+        manager.setConfig(config);
+        if (config.enableVirtualMemory) {
+            manager.enableVirtualMemory(true);
+        }
+        manager.setMemorySnapshotsEnabled(false);
+        // The report needs every finished process, not just the recent ones
+        manager.setFinishedHistoryLimit(std::numeric_limits<size_t>::max());
+
+        CpuClock& clock = manager.getClock();
+        uint64_t interval = std::max<uint64_t>(1, totalTicks / SAMPLE_COUNT);
+        int listenerId = clock.addTickListener([this, &manager, interval](uint64_t tick) {
+            if (tick % interval == 0 && tick <= totalTicks) {
+                takeSample(manager, tick);
+            }
+        });
+
+        manager.startScheduler();
+        manager.startProcessGeneration();
+        clock.waitTicks(totalTicks);
+
+        // Stop at the tick boundary; work still in flight is left unfinished
+        manager.stopProcessGeneration();
+        manager.haltScheduler();
+        clock.removeTickListener(listenerId);
+    } catch (const std::exception& e) {
+        std::cout.rdbuf(originalBuffer);
+        std::cerr << "Simulation failed: " << e.what() << std::endl;
+        return 1;
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::cout.rdbuf(originalBuffer);
+    printReport(manager);
+    std::cout << "Wall time:              " << std::fixed << std::setprecision(2) << wallSeconds << " s ("
+              << std::setprecision(0) << (wallSeconds > 0 ? totalTicks / wallSeconds : 0.0) << " ticks/s)\n";
+    return 0;
+}
+
+void Simulator::takeSample(ProcessManager& manager, uint64_t tick) {
+    // Runs on a core at the end of a tick, so it must stay cheap
+    Sample sample;
+    sample.tick = tick;
+    sample.completedProcesses = manager.getCompletedProcessCount();
+    sample.pageFaults = manager.getPageFaultCount();
+    sample.externalFragmentation = manager.getExternalFragmentation();
+    samples.push_back(sample);
+}
+
+void Simulator::printReport(ProcessManager& manager) const {
+    // Only processes that finished within the simulated window count
+    std::vector<uint64_t> turnaroundTimes;
+    std::vector<uint64_t> waitingTimes;
+    auto processes = manager.getAllProcesses();
+    for (const auto& process : processes) {
+        if (process->getIsActive() || process->getFinishTick() == 0 || process->getFinishTick() > totalTicks) {
+            continue;
+        }
+        uint64_t turnaround = process->getFinishTick() - process->getArrivalTick();
+        turnaroundTimes.push_back(turnaround);
+        // Waiting time is everything not spent on a core: ready queue, memory wait and SLEEP
+        waitingTimes.push_back(turnaround - std::min(turnaround, process->getCpuTicks()));
+    }
+    std::sort(turnaroundTimes.begin(), turnaroundTimes.end());
+    std::sort(waitingTimes.begin(), waitingTimes.end());
+
+    auto mean = [](const std::vector<uint64_t>& values) {
+        return values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    };
+
+    uint64_t pageFaults = samples.empty() ? 0 : samples.back().pageFaults;
+    double completedPerTick = totalTicks > 0 ? static_cast<double>(turnaroundTimes.size()) / totalTicks : 0.0;
+
+    std::cout << "\n=== Simulation Report ===\n";
+    std::cout << "Scheduler:              " << config.scheduler << " (" << config.numCpu << " cores, quantum "
+              << config.quantumCycles << ", delay-per-exec " << config.delaysPerExec << ")\n";
+    std::cout << "Memory:                 " << (config.enableVirtualMemory ? "paged, " + config.pageReplacementAlg
+                                                                            : "flat, hole-fit " + config.holeFitPolicy) << "\n";
+    std::cout << "Ticks simulated:        " << totalTicks << "\n";
+    std::cout << "Processes generated:    " << processes.size() << "\n";
+    std::cout << "Processes completed:    " << turnaroundTimes.size() << "\n";
+    std::cout << "Completed per tick:     " << std::fixed << std::setprecision(4) << completedPerTick << "\n";
+
+    std::cout << std::setprecision(1);
+    std::cout << "\n                        " << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << "\n";
+    std::cout << "Turnaround (ticks):     " << std::setw(10) << mean(turnaroundTimes)
+              << std::setw(10) << percentile(turnaroundTimes, 0.50) << std::setw(10) << percentile(turnaroundTimes, 0.99) << "\n";
+    std::cout << "Waiting (ticks):        " << std::setw(10) << mean(waitingTimes)
+              << std::setw(10) << percentile(waitingTimes, 0.50) << std::setw(10) << percentile(waitingTimes, 0.99) << "\n";
+
+    // Generated programs only issue READ and WRITE under paged memory
+    std::cout << "\nPage faults:            ";
+    if (!config.enableVirtualMemory) {
+        std::cout << "n/a (flat memory)";
+    } else {
+        std::cout << pageFaults;
+        if (totalTicks > 0) {
+            std::cout << " (" << std::setprecision(2) << pageFaults * 1000.0 / totalTicks << " per 1000 ticks)";
+        }
+    }
+    std::cout << "\n";
+
+    std::cout << "\nOver time:\n";
+    std::cout << std::setw(12) << "Tick" << std::setw(12) << "Completed" << std::setw(16) << "Completed/Tick"
+              << std::setw(14) << "Page Faults" << std::setw(16) << "Ext. Frag (B)" << "\n";
+    uint64_t previousTick = 0;
+    uint64_t previousCompleted = 0;
+    for (const auto& sample : samples) {
+        uint64_t span = sample.tick - previousTick;
+        double rate = span > 0 ? static_cast<double>(sample.completedProcesses - previousCompleted) / span : 0.0;
+        std::cout << std::setw(12) << sample.tick << std::setw(12) << sample.completedProcesses
+                  << std::setw(16) << std::setprecision(4) << rate
+                  << std::setw(14) << sample.pageFaults << std::setw(16) << sample.externalFragmentation << "\n";
+        previousTick = sample.tick;
+        previousCompleted = sample.completedProcesses;
+    }
+}
+
+double Simulator::percentile(const std::vector<uint64_t>& sorted, double fraction) {
+    // Nearest-rank percentile of an already sorted list
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return static_cast<double>(sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1]);
+}
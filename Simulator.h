@@ -0,0 +1,40 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <vector>
+#include <cstdint>
+#include "ConsoleManager.h"
+
+class ProcessManager;
+
+// Headless fast-forward run of the full emulator (scheduler, generator and
+// memory managers) for a fixed number of virtual-time ticks, followed by a
+// throughput and latency report. Started with: csopesy --simulate <config> --ticks N
+class Simulator {
+private:
+    // Point-in-time counters taken by a clock listener while the run is in progress
+    struct Sample {
+        uint64_t tick;
+        uint64_t completedProcesses;
+        uint64_t pageFaults;
+        int externalFragmentation;
+    };
+
+    static constexpr int SAMPLE_COUNT = 20;
+
+    Config config;
+    uint64_t totalTicks;
+    std::vector<Sample> samples;
+
+    void takeSample(ProcessManager& manager, uint64_t tick);
+    void printReport(ProcessManager& manager) const;
+    static double percentile(const std::vector<uint64_t>& sorted, double fraction);
+
+public:
+    Simulator(const Config& config, uint64_t ticks);
+
+    // Runs the simulation and prints the report; returns the process exit code
+    int run();
+};
+
+#endif
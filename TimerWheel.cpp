@@ -0,0 +1,89 @@
+#include "TimerWheel.h"
+#include "Process.h"
+
+TimerWheel::TimerWheel() : currentTick(0), entryCount(0) {
+    for (auto& level : levels) {
+        level.resize(SLOTS);
+    }
+}
+
+void TimerWheel::schedule(std::shared_ptr<Process> process, uint64_t delayTicks) {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+
+    // A zero delay would land in the slot that has already fired this tick
+    if (delayTicks == 0) {
+        delayTicks = 1;
+    }
+
+    std::list<TimerEntry> entry;
+    entry.push_back({currentTick + delayTicks, std::move(process)});
+    insert(entry);
+    entryCount++;
+}
+
+std::vector<std::shared_ptr<Process>> TimerWheel::advance() {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    std::vector<std::shared_ptr<Process>> expired;
+
+    currentTick++;
+
+    // When a lower level wraps around, pull the next slot of the level above down
+    if ((currentTick & SLOT_MASK) == 0) {
+        if ((currentTick & ((SLOT_MASK << SLOT_BITS) | SLOT_MASK)) == 0) {
+            if ((currentTick & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)) == 0) {
+                std::list<TimerEntry> pending;
+                pending.swap(overflow);
+                insert(pending);
+            }
+            cascade(2);
+        }
+        cascade(1);
+    }
+
+    std::list<TimerEntry>& slot = levels[0][currentTick & SLOT_MASK];
+    expired.reserve(slot.size());
+    for (auto& entry : slot) {
+        expired.push_back(std::move(entry.process));
+    }
+    entryCount -= slot.size();
+    slot.clear();
+
+    return expired;
+}
+
+size_t TimerWheel::size() const {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    return entryCount;
+}
+
+bool TimerWheel::empty() const {
+    return size() == 0;
+}
+
+void TimerWheel::insert(std::list<TimerEntry>& entries) {
+    // Entries are spliced between lists, so re-sorting them never reallocates
+    while (!entries.empty()) {
+        uint64_t expiry = entries.front().expiryTick;
+        uint64_t delta = expiry > currentTick ? expiry - currentTick : 0;
+
+        std::list<TimerEntry>* target;
+        if (delta < SLOTS) {
+            target = &levels[0][expiry & SLOT_MASK];
+        } else if (delta < (uint64_t(1) << (SLOT_BITS * 2))) {
+            target = &levels[1][(expiry >> SLOT_BITS) & SLOT_MASK];
+        } else if (delta < (uint64_t(1) << (SLOT_BITS * 3))) {
+            target = &levels[2][(expiry >> (SLOT_BITS * 2)) & SLOT_MASK];
+        } else {
+            target = &overflow;
+        }
+
+        target->splice(target->end(), entries, entries.begin());
+    }
+}
+
+void TimerWheel::cascade(int level) {
+    uint64_t index = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+    std::list<TimerEntry> pending;
+    pending.swap(levels[level][index]);
+    insert(pending);
+}
@@ -0,0 +1,50 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+class Process;
+
+// Hierarchical timer wheel for parking sleeping processes.
+// Three levels of 64 slots cover delays of up to 64^3 ticks with O(1)
+// insertion and O(1) amortized expiry; longer delays wait in an overflow
+// list that is re-sorted into the wheel once per full level-2 rotation.
+class TimerWheel {
+private:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;   // 64 slots per level
+    static constexpr int LEVELS = 3;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    struct TimerEntry {
+        uint64_t expiryTick;
+        std::shared_ptr<Process> process;
+    };
+
+    std::vector<std::list<TimerEntry>> levels[LEVELS];
+    std::list<TimerEntry> overflow;
+    uint64_t currentTick;
+    size_t entryCount;
+    mutable std::mutex wheelMutex;
+
+    void insert(std::list<TimerEntry>& entries);
+    void cascade(int level);
+
+public:
+    TimerWheel();
+
+    // Park a process until delayTicks ticks from now (at least 1)
+    void schedule(std::shared_ptr<Process> process, uint64_t delayTicks);
+
+    // Advance the wheel by one tick and return the processes whose timers expired
+    std::vector<std::shared_ptr<Process>> advance();
+
+    size_t size() const;
+    bool empty() const;
+};
+
+#endif
@@ -5,118 +5,380 @@
 #include <chrono>
 #include <algorithm>
 #include <cstring>
+#include <cerrno>
+#include <bit>
+#include <bitset>
+#ifdef _WIN32
+#include <filesystem>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // FrameAllocator Implementation
 FrameAllocator::FrameAllocator(int totalMemory, int frameSize) 
-    : frameSize(frameSize), totalFrames(totalMemory / frameSize) {
-    frameStatus.resize(totalFrames, false);
-    
-    // Initialize free frames queue
-    for (int i = 0; i < totalFrames; ++i) {
-        freeFrames.push(i);
-    }
+    : totalFrames(totalMemory / frameSize), frameSize(frameSize) {
+    // One buddy unit per frame
+    blocks.reset(totalFrames, 1);
 }
 
-int FrameAllocator::allocateFrame() {
+int FrameAllocator::allocateFrames(int count) {
     std::lock_guard<std::mutex> lock(frameMutex);
-    
-    if (freeFrames.empty()) {
-        return -1;  // No free frames available
-    }
-    
-    int frameNumber = freeFrames.front();
-    freeFrames.pop();
-    frameStatus[frameNumber] = true;
-    
-    return frameNumber;
+    return blocks.allocate(count);  // -1 when no aligned run is free
 }
 
 void FrameAllocator::deallocateFrame(int frameNumber) {
     std::lock_guard<std::mutex> lock(frameMutex);
     
-    if (frameNumber >= 0 && frameNumber < totalFrames && frameStatus[frameNumber]) {
-        frameStatus[frameNumber] = false;
-        freeFrames.push(frameNumber);
+    if (frameNumber >= 0 && frameNumber < totalFrames && blocks.allocatedBlockSize(frameNumber) > 0) {
+        blocks.release(frameNumber);
     }
 }
 
 bool FrameAllocator::hasAvailableFrames() const {
     std::lock_guard<std::mutex> lock(frameMutex);
-    return !freeFrames.empty();
+    return blocks.getFreeBytes() > 0;
 }
 
 int FrameAllocator::getAvailableFrameCount() const {
     std::lock_guard<std::mutex> lock(frameMutex);
-    return freeFrames.size();
+    return blocks.getFreeBytes();
 }
 
 // BackingStore Implementation
-BackingStore::BackingStore(const std::string& filename, int blockSize) 
-    : filename(filename), blockSize(blockSize), nextFreeBlock(0) {
+BackingStore::SyncPolicy BackingStore::parseSyncPolicy(const std::string& name) {
+    if (name == "batch") {
+        return SyncPolicy::BATCH;
+    }
+    if (name == "always") {
+        return SyncPolicy::ALWAYS;
+    }
+    return SyncPolicy::NONE;
+}
+
+BackingStore::BackingStore(const std::string& filename, int blockSize, size_t writeBackPages, SyncPolicy policy) 
+    : filename(filename), blockSize(blockSize), syncPolicy(policy),
+      writeBackCapacity(policy == SyncPolicy::ALWAYS ? 0 : writeBackPages) {
+    pendingData.reserve(writeBackCapacity * blockSize);
     initialize();
 }
 
 BackingStore::~BackingStore() {
+    // Buffered pages belong to address spaces that die with the manager, so they are dropped
+#ifdef _WIN32
     if (backingFile.is_open()) {
         backingFile.close();
     }
+#else
+    if (fd != -1) {
+        ::close(fd);
+    }
+#endif
 }
 
 void BackingStore::initialize() {
     std::lock_guard<std::mutex> lock(fileMutex);
     
-    backingFile.open(filename, std::ios::binary | std::ios::in | std::ios::out);
-    
+    // Pages only live as long as the manager, so every run starts from an empty file
+#ifdef _WIN32
+    backingFile.open(filename, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
     if (!backingFile.is_open()) {
-        // Create new file if it doesn't exist
-        backingFile.open(filename, std::ios::binary | std::ios::out);
-        backingFile.close();
-        backingFile.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+        throw std::runtime_error("Failed to open backing store file: " + filename);
     }
-    
-    if (!backingFile.is_open()) {
+#else
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
         throw std::runtime_error("Failed to open backing store file: " + filename);
     }
+#endif
 }
 
-void BackingStore::storePage(int frameNumber, uint32_t diskAddress, const uint8_t* pageData) {
+void BackingStore::writeAt(uint32_t offset, const uint8_t* data, size_t length) {
+#ifdef _WIN32
+    backingFile.clear();
+    backingFile.seekp(offset);
+    backingFile.write(reinterpret_cast<const char*>(data), length);
+    fileBytes = std::max<uint64_t>(fileBytes, static_cast<uint64_t>(offset) + length);
+#else
+    fileBytes = std::max<uint64_t>(fileBytes, static_cast<uint64_t>(offset) + length);
+    while (length > 0) {
+        ssize_t written = ::pwrite(fd, data, length, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Backing store write failed: " + std::string(std::strerror(errno)));
+        }
+        data += written;
+        offset += static_cast<uint32_t>(written);
+        length -= static_cast<size_t>(written);
+    }
+#endif
+}
+
+size_t BackingStore::readAt(uint32_t offset, uint8_t* data, size_t length) {
+#ifdef _WIN32
+    backingFile.clear();
+    backingFile.seekg(offset);
+    backingFile.read(reinterpret_cast<char*>(data), length);
+    size_t loaded = static_cast<size_t>(backingFile.gcount());
+    backingFile.clear();
+    return loaded;
+#else
+    size_t loaded = 0;
+    while (loaded < length) {
+        ssize_t count = ::pread(fd, data + loaded, length - loaded, offset + loaded);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;  // EOF: the page was never written out
+        }
+        loaded += static_cast<size_t>(count);
+    }
+    return loaded;
+#endif
+}
+
+void BackingStore::syncFile() {
+#ifdef _WIN32
+    backingFile.flush();
+#else
+    ::fsync(fd);
+#endif
+}
+
+void BackingStore::flushPendingLocked() {
+    if (pendingPages.empty()) {
+        pendingData.clear();
+        return;
+    }
+    
+    // pendingPages is address ordered; gather each contiguous run and write it at once
+    std::vector<uint8_t> run;
+    uint32_t runStart = 0;
+    uint32_t runEnd = 0;
+    for (const auto& [diskAddress, index] : pendingPages) {
+        if (!run.empty() && diskAddress != runEnd) {
+            writeAt(runStart, run.data(), run.size());
+            run.clear();
+        }
+        if (run.empty()) {
+            runStart = diskAddress;
+        }
+        const uint8_t* page = &pendingData[index * blockSize];
+        run.insert(run.end(), page, page + blockSize);
+        runEnd = diskAddress + blockSize;
+    }
+    writeAt(runStart, run.data(), run.size());
+    
+    pendingPages.clear();
+    pendingData.clear();
+    
+    if (syncPolicy != SyncPolicy::NONE) {
+        syncFile();
+    }
+}
+
+void BackingStore::flush() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    flushPendingLocked();
+}
+
+void BackingStore::storePage(uint32_t diskAddress, const uint8_t* pageData, int blocks) {
     std::lock_guard<std::mutex> lock(fileMutex);
     
-    backingFile.seekp(diskAddress);
-    backingFile.write(reinterpret_cast<const char*>(pageData), blockSize);
-    backingFile.flush();
+    if (writeBackCapacity == 0) {
+        // Write-through; a huge page's slots are contiguous, so this is one write
+        writeAt(diskAddress, pageData, static_cast<size_t>(blocks) * blockSize);
+        if (syncPolicy != SyncPolicy::NONE) {
+            syncFile();
+        }
+        return;
+    }
+    
+    for (int i = 0; i < blocks; ++i) {
+        storeBlockLocked(diskAddress + i * blockSize, pageData + i * blockSize);
+    }
 }
 
-void BackingStore::loadPage(uint32_t diskAddress, int frameNumber, uint8_t* pageData) {
+void BackingStore::storeBlockLocked(uint32_t diskAddress, const uint8_t* data) {
+    // A page evicted again before the batch went out just replaces its buffered copy
+    auto it = pendingPages.find(diskAddress);
+    if (it != pendingPages.end()) {
+        std::memcpy(&pendingData[it->second * blockSize], data, blockSize);
+        return;
+    }
+    
+    pendingPages[diskAddress] = pendingData.size() / blockSize;
+    pendingData.insert(pendingData.end(), data, data + blockSize);
+    
+    // Counted in buffer slots, so slots of freed pages also trigger the batch
+    if (pendingData.size() / blockSize >= writeBackCapacity) {
+        flushPendingLocked();
+    }
+}
+
+void BackingStore::loadPage(uint32_t diskAddress, uint8_t* pageData, int blocks) {
     std::lock_guard<std::mutex> lock(fileMutex);
     
-    backingFile.seekg(diskAddress);
-    backingFile.read(reinterpret_cast<char*>(pageData), blockSize);
+    for (int i = 0; i < blocks; ++i) {
+        loadBlockLocked(diskAddress + i * blockSize, pageData + i * blockSize);
+    }
+}
+
+void BackingStore::loadBlockLocked(uint32_t diskAddress, uint8_t* data) {
+    auto it = pendingPages.find(diskAddress);
+    if (it != pendingPages.end()) {
+        std::memcpy(data, &pendingData[it->second * blockSize], blockSize);
+        return;
+    }
+    
+    // Every slot is written when it is assigned, so a short read is an I/O error; keep the frame defined
+    size_t loaded = readAt(diskAddress, data, blockSize);
+    if (loaded < static_cast<size_t>(blockSize)) {
+        std::memset(data + loaded, 0, blockSize - loaded);
+    }
+}
+
+bool BackingStore::slotUsed(uint32_t slot) const {
+    return slot / 64 < slotBitmap.size() && (slotBitmap[slot / 64] & (uint64_t(1) << (slot % 64)));
 }
 
-uint32_t BackingStore::allocateDiskSpace() {
+uint32_t BackingStore::allocateDiskSpace(int blocks) {
     std::lock_guard<std::mutex> lock(fileMutex);
     
-    uint32_t allocated = nextFreeBlock;
-    nextFreeBlock += blockSize;
-    allocatedBlocks[allocated] = true;
+    uint32_t slot;
+    if (blocks == 1) {
+        // Scan whole words for a clear bit, starting where the last search left off
+        size_t word = searchHint / 64;
+        while (word < slotBitmap.size() && slotBitmap[word] == ~uint64_t(0)) {
+            ++word;
+        }
+        if (word == slotBitmap.size()) {
+            slotBitmap.push_back(0);
+        }
+        slot = static_cast<uint32_t>(word * 64 + std::countr_zero(~slotBitmap[word]));
+        searchHint = slot;
+    } else {
+        // A huge page needs a contiguous run; first fit from the hint, and leave
+        // the hint alone so single slots keep filling the holes below
+        slot = searchHint;
+        uint32_t run = 0;
+        while (run < static_cast<uint32_t>(blocks)) {
+            if (slotUsed(slot + run)) {
+                slot += run + 1;
+                run = 0;
+            } else {
+                ++run;
+            }
+        }
+        slotBitmap.resize(std::max(slotBitmap.size(), static_cast<size_t>((slot + blocks + 63) / 64)), 0);
+    }
     
-    return allocated;
+    for (int i = 0; i < blocks; ++i) {
+        slotBitmap[(slot + i) / 64] |= uint64_t(1) << ((slot + i) % 64);
+    }
+    usedSlots += blocks;
+    slotLimit = std::max(slotLimit, slot + blocks);
+    
+    return slot * blockSize;
 }
 
-void BackingStore::deallocateDiskSpace(uint32_t diskAddress) {
+void BackingStore::deallocateDiskSpace(uint32_t diskAddress, int blocks) {
     std::lock_guard<std::mutex> lock(fileMutex);
-    allocatedBlocks.erase(diskAddress);
+    
+    for (int i = 0; i < blocks; ++i) {
+        releaseSlotLocked(diskAddress / blockSize + i);
+    }
+    
+    // Pull the limit down over any free slots now at the tail
+    while (slotLimit > 0 && !slotUsed(slotLimit - 1)) {
+        --slotLimit;
+    }
+}
+
+void BackingStore::releaseSlotLocked(uint32_t slot) {
+    if (!slotUsed(slot)) {
+        return;
+    }
+    slotBitmap[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    --usedSlots;
+    searchHint = std::min(searchHint, slot);
+    
+    // A freed page never needs to reach the file. Its buffer slot stays
+    // allocated until the next flush; only the index entry goes.
+    pendingPages.erase(slot * blockSize);
+}
+
+void BackingStore::compact() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    
+    uint64_t liveBytes = static_cast<uint64_t>(slotLimit) * blockSize;
+    if (fileBytes <= liveBytes) {
+        return;
+    }
+    
+    // Buffered pages are all below slotLimit, so truncation cannot lose them
+#ifdef _WIN32
+    backingFile.flush();
+    backingFile.close();
+    std::filesystem::resize_file(filename, liveBytes);
+    backingFile.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+#else
+    if (::ftruncate(fd, static_cast<off_t>(liveBytes)) != 0) {
+        std::cerr << "Warning: Failed to compact backing store: " << std::strerror(errno) << std::endl;
+        return;
+    }
+#endif
+    fileBytes = liveBytes;
+    slotBitmap.resize((slotLimit + 63) / 64);
+}
+
+bool BackingStore::shouldCompact() const {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    // The minimum keeps small stores from truncating on every release
+    uint64_t liveBytes = static_cast<uint64_t>(slotLimit) * blockSize;
+    return fileBytes > 2 * liveBytes && fileBytes - liveBytes >= 64 * static_cast<uint64_t>(blockSize);
+}
+
+uint64_t BackingStore::getFileSize() const {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return fileBytes;
+}
+
+uint64_t BackingStore::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return static_cast<uint64_t>(usedSlots) * blockSize;
 }
 
 // VirtualMemoryManager Implementation
-VirtualMemoryManager::VirtualMemoryManager(int totalPhysicalMemory, int frameSize) {
+VirtualMemoryManager::VirtualMemoryManager(int totalPhysicalMemory, int frameSize, const std::string& replacementAlg,
+                                           const std::string& backingStoreSync) {
+    // Page numbers and offsets are a shift and a mask, so the frame size must be a power of two
+    if (frameSize <= 0 || !std::has_single_bit(static_cast<unsigned>(frameSize))) {
+        int rounded = static_cast<int>(std::bit_ceil(static_cast<unsigned>(std::max(frameSize, 1))));
+        std::cerr << "Warning: mem-per-frame " << frameSize << " is not a power of two, using "
+                  << rounded << std::endl;
+        frameSize = rounded;
+    }
+    pageSize = frameSize;
+    pageShift = std::countr_zero(static_cast<unsigned>(frameSize));
+    
     // Initialize physical memory
     physicalMemory.resize(totalPhysicalMemory, 0);
     
     // Initialize components
     frameAllocator = std::make_unique<FrameAllocator>(totalPhysicalMemory, frameSize);
-    backingStore = std::make_unique<BackingStore>("csopesy-backing-store.txt", frameSize);
+    frameTable.resize(frameAllocator->getTotalFrames());
+    prefetchedFrames = std::vector<std::atomic<bool>>(frameAllocator->getTotalFrames());
+    faultedFrames = std::vector<std::atomic<bool>>(frameAllocator->getTotalFrames());
+    replacementPolicy = ReplacementPolicy::create(replacementAlg, frameAllocator->getTotalFrames());
+    // The write-back batch grows with memory so page-out runs stay long under thrashing
+    size_t writeBackPages = std::clamp(frameAllocator->getTotalFrames() / 4, 16, 1024);
+    backingStore = std::make_unique<BackingStore>("csopesy-backing-store.txt", frameSize, writeBackPages,
+                                                  BackingStore::parseSyncPolicy(backingStoreSync));
     
     std::cout << "Virtual Memory Manager initialized with " << totalPhysicalMemory 
               << " bytes physical memory, " << frameSize << " bytes per frame" << std::endl;
@@ -135,27 +397,26 @@ bool VirtualMemoryManager::allocateVirtualMemory(int processId, size_t size) {
     }
     
     // Check if process already has memory allocated
-    if (processPageTables.find(processId) != processPageTables.end()) {
+    if (processId < 0 || findAddressSpace(processId)) {
         std::cerr << "Error: Process " << processId << " already has memory allocated" << std::endl;
         return false;
     }
     
-    // Calculate number of pages needed
-    int pagesNeeded = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    // Large processes get huge pages, fewer faults and page-table entries per byte
+    int spaceShift = (hugePageShift > 0 && size >= hugePageThreshold) ? hugePageShift : pageShift;
+    size_t spacePageSize = size_t(1) << spaceShift;
+    int pagesNeeded = static_cast<int>((size + spacePageSize - 1) >> spaceShift);
     
     // Initialize page table for this process
-    processPageTables[processId].resize(pagesNeeded);
-    processMemorySizes[processId] = size;
-    processBaseAddresses[processId] = 0;  // Virtual addresses start at 0 for each process
-    
-    // Initialize pages (all start as not present - demand paging)
-    for (int i = 0; i < pagesNeeded; ++i) {
-        processPageTables[processId][i] = PageTableEntry();
-        processPageTables[processId][i].diskAddress = backingStore->allocateDiskSpace();
-    }
+    AddressSpace& space = createAddressSpace(processId);
+    space.size = size;
+    space.baseAddress = 0;  // Virtual addresses start at 0 for each process
+    space.pageShift = spaceShift;
+    space.pageTable.resize(pagesNeeded);
     
-    std::cout << "Allocated " << size << " bytes (" << pagesNeeded << " pages) for process " 
-              << processId << std::endl;
+    // Pages start not present and without a disk slot; first touch zero-fills
+    std::cout << "Allocated " << size << " bytes (" << pagesNeeded << " pages of " << spacePageSize
+              << " bytes) for process " << processId << std::endl;
     
     return true;
 }
@@ -163,155 +424,477 @@ bool VirtualMemoryManager::allocateVirtualMemory(int processId, size_t size) {
 void VirtualMemoryManager::deallocateVirtualMemory(int processId) {
     std::unique_lock<std::shared_mutex> lock(vmMutex);
     
-    auto it = processPageTables.find(processId);
-    if (it == processPageTables.end()) {
+    AddressSpace* space = findAddressSpace(processId);
+    if (!space) {
         return;  // Process not found
     }
     
+    drainAccessLogs();
+    
     // Free all physical frames used by this process
-    for (auto& entry : it->second) {
+    int blocks = framesPerPage(*space);
+    for (size_t page = 0; page < space->pageTable.size(); ++page) {
+        auto& entry = space->pageTable[page];
         if (entry.present) {
+            tlbShootdown(*space, static_cast<int>(page));
+            unmapFrame(entry.frameNumber, false);
             frameAllocator->deallocateFrame(entry.frameNumber);
         }
         // Free backing store space
-        backingStore->deallocateDiskSpace(entry.diskAddress);
+        if (entry.hasDiskSlot()) {
+            backingStore->deallocateDiskSpace(entry.diskAddress, blocks);
+        }
     }
     
-    // Remove from tracking maps
-    processPageTables.erase(it);
-    processMemorySizes.erase(processId);
-    processBaseAddresses.erase(processId);
+    releaseAddressSpace(*space);
+    
+    if (compactBackingStore && backingStore->shouldCompact()) {
+        backingStore->compact();
+    }
     
     std::cout << "Deallocated memory for process " << processId << std::endl;
 }
 
 bool VirtualMemoryManager::translateAddress(int processId, uint32_t virtualAddr, uint32_t& physicalAddr) {
     std::shared_lock<std::shared_mutex> lock(vmMutex);
-    
-    if (!isValidMemoryAccess(processId, virtualAddr)) {
-        return false;
+    return translateLocked(processId, virtualAddr, physicalAddr) != nullptr;
+}
+
+PageTableEntry* VirtualMemoryManager::translateLocked(int processId, uint32_t virtualAddr, uint32_t& physicalAddr, int coreId) {
+    AddressSpace* space = findAddressSpace(processId);
+    if (!space || virtualAddr >= space->size) {
+        return nullptr;
     }
     
-    int pageNumber = getPageNumber(virtualAddr);
-    int offset = getPageOffset(virtualAddr);
-    
-    auto& pageTable = processPageTables[processId];
-    
-    if (!pageTable[pageNumber].present) {
+    PageTableEntry& entry = space->pageTable[spacePage(*space, virtualAddr)];
+    if (!entry.present) {
         // Page fault will be handled by caller
-        return false;
+        return nullptr;
     }
     
-    // Update access time for LRU
-    updateAccessTime(pageTable[pageNumber]);
+    // First use of a read-ahead page; it only ever reaches here, never the TLB
+    std::atomic<bool>& prefetched = prefetchedFrames[entry.frameNumber];
+    if (prefetched.load(std::memory_order_relaxed) && prefetched.exchange(false, std::memory_order_relaxed)) {
+        prefetchHits.fetch_add(1, std::memory_order_relaxed);
+    }
     
-    physicalAddr = getPhysicalAddress(pageTable[pageNumber].frameNumber, offset);
-    return true;
+    // Record the access for the replacement policy, unless it is the one that faulted the page in
+    std::atomic<bool>& faulted = faultedFrames[entry.frameNumber];
+    if (!faulted.load(std::memory_order_relaxed) || !faulted.exchange(false, std::memory_order_relaxed)) {
+        updateAccessTime(entry, coreId);
+    }
+    
+    // A huge page's frames are contiguous, so its offset runs straight across them
+    uint32_t offset = virtualAddr & ((uint32_t(1) << space->pageShift) - 1);
+    physicalAddr = getPhysicalAddress(entry.frameNumber, static_cast<int>(offset));
+    return &entry;
 }
 
-uint16_t VirtualMemoryManager::readMemory(int processId, uint32_t virtualAddr) {
-    uint32_t physicalAddr;
+uint16_t VirtualMemoryManager::readMemory(int processId, uint32_t virtualAddr, int coreId) {
+    uint16_t value = 0;
+    if (tlbAccess(coreId, processId, virtualAddr, false, value)) {
+        return value;
+    }
     
-    // Try to translate address
-    if (!translateAddress(processId, virtualAddr, physicalAddr)) {
-        // Handle page fault
-        handlePageFault(processId, virtualAddr);
-        
-        // Retry translation
-        if (!translateAddress(processId, virtualAddr, physicalAddr)) {
-            throw std::runtime_error("Failed to translate address after page fault handling");
+    // Fault the page in again if another core evicts it before the retry
+    for (int attempt = 0; attempt < FAULT_RETRY_LIMIT; ++attempt) {
+        if (pageTableAccess(processId, virtualAddr, false, value, coreId)) {
+            return value;
         }
+        handlePageFault(processId, virtualAddr);
     }
-    
-    // Read from physical memory (assuming little-endian 16-bit values)
-    uint16_t value = 0;
-    if (physicalAddr + 1 < physicalMemory.size()) {
-        value = physicalMemory[physicalAddr] | (physicalMemory[physicalAddr + 1] << 8);
+    throw std::runtime_error("Failed to translate address after page fault handling");
+}
+
+void VirtualMemoryManager::writeMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId) {
+    if (tlbAccess(coreId, processId, virtualAddr, true, value)) {
+        return;
     }
     
-    return value;
+    for (int attempt = 0; attempt < FAULT_RETRY_LIMIT; ++attempt) {
+        if (pageTableAccess(processId, virtualAddr, true, value, coreId)) {
+            return;
+        }
+        handlePageFault(processId, virtualAddr);
+    }
+    throw std::runtime_error("Failed to translate address after page fault handling");
 }
 
-void VirtualMemoryManager::writeMemory(int processId, uint32_t virtualAddr, uint16_t value) {
-    uint32_t physicalAddr;
+bool VirtualMemoryManager::tryReadMemory(int processId, uint32_t virtualAddr, uint16_t& value, int coreId) {
+    return tlbAccess(coreId, processId, virtualAddr, false, value) ||
+           pageTableAccess(processId, virtualAddr, false, value, coreId);
+}
+
+bool VirtualMemoryManager::tryWriteMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId) {
+    return tlbAccess(coreId, processId, virtualAddr, true, value) ||
+           pageTableAccess(processId, virtualAddr, true, value, coreId);
+}
+
+bool VirtualMemoryManager::pageTableAccess(int processId, uint32_t virtualAddr, bool isWrite, uint16_t& value, int coreId) {
+    // Writes take vmMutex exclusively, since the dirty bit is set in the page table
+    std::shared_lock<std::shared_mutex> readLock(vmMutex, std::defer_lock);
+    std::unique_lock<std::shared_mutex> writeLock(vmMutex, std::defer_lock);
+    if (isWrite) {
+        writeLock.lock();
+    } else {
+        readLock.lock();
+    }
     
-    // Try to translate address
-    if (!translateAddress(processId, virtualAddr, physicalAddr)) {
-        // Handle page fault
-        handlePageFault(processId, virtualAddr);
-        
-        // Retry translation
-        if (!translateAddress(processId, virtualAddr, physicalAddr)) {
-            throw std::runtime_error("Failed to translate address after page fault handling");
+    uint32_t physicalAddr;
+    PageTableEntry* entry = translateLocked(processId, virtualAddr, physicalAddr, coreId);
+    if (!entry) {
+        if (!isValidMemoryAccess(processId, virtualAddr)) {
+            throw PageFaultException(processId, virtualAddr, "Access violation: address outside process memory");
         }
+        return false;
     }
     
-    // Mark page as dirty
-    {
-        std::unique_lock<std::shared_mutex> lock(vmMutex);
-        int pageNumber = getPageNumber(virtualAddr);
-        processPageTables[processId][pageNumber].dirty = true;
+    if (isWrite) {
+        entry->dirty = true;
+        storeWord(physicalAddr, value);
+    } else {
+        value = loadWord(physicalAddr);
     }
-    
-    // Write to physical memory (little-endian 16-bit values)
+    tlbFill(coreId, processId, virtualAddr, *entry);
+    return true;
+}
+
+uint16_t VirtualMemoryManager::loadWord(uint32_t physicalAddr) const {
+    if (physicalAddr + 1 < physicalMemory.size()) {
+        return physicalMemory[physicalAddr] | (physicalMemory[physicalAddr + 1] << 8);
+    }
+    return 0;
+}
+
+void VirtualMemoryManager::storeWord(uint32_t physicalAddr, uint16_t value) {
     if (physicalAddr + 1 < physicalMemory.size()) {
         physicalMemory[physicalAddr] = value & 0xFF;
         physicalMemory[physicalAddr + 1] = (value >> 8) & 0xFF;
     }
 }
 
-void VirtualMemoryManager::handlePageFault(int processId, uint32_t virtualAddr) {
-    std::lock_guard<std::mutex> pageFaultLock(pageFaultMutex);
-    std::unique_lock<std::shared_mutex> vmLock(vmMutex);
+void VirtualMemoryManager::setBackingStoreCompaction(bool enabled) {
+    std::unique_lock<std::shared_mutex> lock(vmMutex);
+    compactBackingStore = enabled;
+}
+
+void VirtualMemoryManager::setHugePages(int hugePageSize, size_t threshold) {
+    std::unique_lock<std::shared_mutex> lock(vmMutex);
     
+    hugePageShift = 0;
+    hugePageThreshold = threshold;
+    if (hugePageSize == 0) {
+        return;
+    }
+    
+    // A huge page is an aligned buddy block of frames, so it must fit the largest one
+    int largestBlock = static_cast<int>(std::bit_floor(static_cast<unsigned>(frameAllocator->getTotalFrames()))) * pageSize;
+    if (hugePageSize < 0 || !std::has_single_bit(static_cast<unsigned>(hugePageSize)) ||
+        hugePageSize <= pageSize || hugePageSize > largestBlock) {
+        std::cerr << "Warning: huge-page-size " << hugePageSize << " must be a power of two above "
+                  << pageSize << " and at most " << largestBlock << ", huge pages disabled" << std::endl;
+        return;
+    }
+    hugePageShift = std::countr_zero(static_cast<unsigned>(hugePageSize));
+}
+
+void VirtualMemoryManager::setCoreCount(int cores) {
+    std::unique_lock<std::shared_mutex> lock(vmMutex);
+    coreTlbs.clear();
+    for (int i = 0; i < cores; ++i) {
+        coreTlbs.push_back(std::make_unique<Tlb>());
+    }
+}
+
+int VirtualMemoryManager::tlbSlot(int processId, int pageNumber) {
+    return (pageNumber ^ (processId * 7)) & (TLB_ENTRIES - 1);
+}
+
+bool VirtualMemoryManager::tlbAccess(int coreId, int processId, uint32_t virtualAddr, bool isWrite, uint16_t& value) {
+    if (coreId < 0 || coreId >= static_cast<int>(coreTlbs.size())) {
+        return false;
+    }
+    Tlb& tlb = *coreTlbs[coreId];
     int pageNumber = getPageNumber(virtualAddr);
-    auto& pageTable = processPageTables[processId];
     
-    if (pageTable[pageNumber].present) {
-        return;  // Page was loaded by another thread
+    std::lock_guard<std::mutex> lock(tlb.mutex);
+    TlbEntry& entry = tlb.entries[tlbSlot(processId, pageNumber)];
+    if (entry.processId != processId || entry.pageNumber != pageNumber ||
+        virtualAddr >= entry.processSize || (isWrite && !entry.dirty)) {
+        tlb.misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
     
-    ++pageFaults;
-    ++pagesIn;
+    entry.pte->referenced.store(true, std::memory_order_relaxed);
+    logAccess(tlb, static_cast<int>(entry.pageFrame));
+    uint32_t physicalAddr = getPhysicalAddress(entry.frameNumber, getPageOffset(virtualAddr));
+    if (isWrite) {
+        storeWord(physicalAddr, value);
+    } else {
+        value = loadWord(physicalAddr);
+    }
+    tlb.hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void VirtualMemoryManager::tlbFill(int coreId, int processId, uint32_t virtualAddr, PageTableEntry& entry) {
+    // Called with vmMutex held, so the page cannot be evicted under us
+    if (coreId < 0 || coreId >= static_cast<int>(coreTlbs.size())) {
+        return;
+    }
+    Tlb& tlb = *coreTlbs[coreId];
+    int pageNumber = getPageNumber(virtualAddr);
     
-    // Try to allocate a free frame
-    int frameNumber = frameAllocator->allocateFrame();
+    std::lock_guard<std::mutex> lock(tlb.mutex);
+    TlbEntry& slot = tlb.entries[tlbSlot(processId, pageNumber)];
+    slot.processId = processId;
+    slot.pageNumber = pageNumber;
+    // Entries stay frame-sized; within a huge page, pick the frame this page lands in
+    const AddressSpace& space = *findAddressSpace(processId);
+    slot.frameNumber = entry.frameNumber + (pageNumber & (framesPerPage(space) - 1));
+    slot.pageFrame = entry.frameNumber;
+    slot.processSize = static_cast<uint32_t>(space.size);
+    slot.dirty = entry.dirty;
+    slot.pte = &entry;
+}
+
+void VirtualMemoryManager::tlbShootdown(const AddressSpace& space, int pageNumber) {
+    // Called with vmMutex held exclusively; waits out any hit in progress on each core.
+    // Hits logged since the last drain are dropped with the entries, or the next
+    // drain would credit them to whatever page the frame holds by then.
+    int processId = space.processId;
+    int count = framesPerPage(space);
+    int firstPage = pageNumber * count;
+    int pageFrame = space.pageTable[pageNumber].frameNumber;
+    if (count == 1) {
+        int slotIndex = tlbSlot(processId, firstPage);
+        for (auto& tlb : coreTlbs) {
+            std::lock_guard<std::mutex> lock(tlb->mutex);
+            TlbEntry& slot = tlb->entries[slotIndex];
+            if (slot.processId == processId && slot.pageNumber == firstPage) {
+                slot = TlbEntry();
+            }
+            dropLoggedAccesses(*tlb, pageFrame);
+        }
+        return;
+    }
     
-    // If no free frames, evict a page
-    if (frameNumber == -1) {
-        int victimFrame = selectVictimPage();
-        if (victimFrame != -1) {
-            frameAllocator->deallocateFrame(victimFrame);
-            frameNumber = frameAllocator->allocateFrame();
+    // A huge page covers many frame-sized entries; sweeping the whole TLB is cheaper than probing each
+    for (auto& tlb : coreTlbs) {
+        std::lock_guard<std::mutex> lock(tlb->mutex);
+        for (TlbEntry& slot : tlb->entries) {
+            if (slot.processId == processId && slot.pageNumber >= firstPage && slot.pageNumber < firstPage + count) {
+                slot = TlbEntry();
+            }
         }
+        dropLoggedAccesses(*tlb, pageFrame);
     }
+}
+
+void VirtualMemoryManager::handlePageFault(int processId, uint32_t virtualAddr) {
+    // The page size depends on the process, so look it up before picking the stripe
+    int pageNumber;
+    int pageBytes;
+    {
+        std::shared_lock<std::shared_mutex> vmLock(vmMutex);
+        if (!isValidMemoryAccess(processId, virtualAddr)) {
+            throw PageFaultException(processId, virtualAddr, "Access violation: address outside process memory");
+        }
+        const AddressSpace& space = *findAddressSpace(processId);
+        pageNumber = spacePage(space, virtualAddr);
+        pageBytes = framesPerPage(space) * pageSize;
+    }
+    uint64_t pageKey = makePageKey(processId, pageNumber);
+    int faultStripe = static_cast<int>(pageKey % FAULT_LOCK_STRIPES);
+    std::lock_guard<std::mutex> pageLock(faultLocks[faultStripe]);
     
-    if (frameNumber == -1) {
-        throw std::runtime_error("Unable to allocate frame for page fault");
+    // Reserve frames for the faulting page and any read-ahead. They stay
+    // unmapped until the reads complete, so neither the policy nor any TLB
+    // can hand them to another thread in the meantime.
+    std::vector<PageLoad> loads;
+    std::vector<std::unique_lock<std::mutex>> readAheadLocks;
+    {
+        std::unique_lock<std::shared_mutex> vmLock(vmMutex);
+        
+        if (!isValidMemoryAccess(processId, virtualAddr)) {
+            throw PageFaultException(processId, virtualAddr, "Access violation: address outside process memory");
+        }
+        
+        AddressSpace& space = *findAddressSpace(processId);
+        if (spacePage(space, virtualAddr) != pageNumber || framesPerPage(space) * pageSize != pageBytes) {
+            return;  // The process was replaced in between; the caller retries
+        }
+        PageTableEntry& entry = space.pageTable[pageNumber];
+        if (entry.present) {
+            return;  // Page was loaded by another thread
+        }
+        
+        drainAccessLogs();
+        replacementPolicy->onFault(pageKey);
+        ++pageFaults;
+        
+        int frameNumber = claimFrames(framesPerPage(space));
+        if (frameNumber == -1) {
+            replacementPolicy->onFaultAbandoned(pageKey);
+            throw std::runtime_error("Unable to allocate frame for page fault");
+        }
+        loads.push_back({pageNumber, frameNumber, entry.diskAddress});
+        planReadAhead(space, pageNumber, faultStripe, loads, readAheadLocks);
     }
     
-    // Load page from backing store
-    uint8_t* pageData = &physicalMemory[frameNumber * PAGE_SIZE];
-    backingStore->loadPage(pageTable[pageNumber].diskAddress, frameNumber, pageData);
+    // A page that was never written out has no slot and starts zeroed
+    for (const PageLoad& load : loads) {
+        uint8_t* pageData = &physicalMemory[getPhysicalAddress(load.frameNumber, 0)];
+        if (load.diskAddress != PageTableEntry::NO_DISK_SLOT) {
+            backingStore->loadPage(load.diskAddress, pageData, pageBytes / pageSize);
+        } else {
+            std::memset(pageData, 0, pageBytes);
+        }
+    }
     
-    // Update page table entry
-    pageTable[pageNumber].present = true;
-    pageTable[pageNumber].frameNumber = frameNumber;
-    pageTable[pageNumber].referenced = true;
-    updateAccessTime(pageTable[pageNumber]);
+    std::unique_lock<std::shared_mutex> vmLock(vmMutex);
+    AddressSpace* space = findAddressSpace(processId);
+    if (!space) {
+        // The process released its memory while the pages were in flight
+        replacementPolicy->onFaultAbandoned(pageKey);
+        for (const PageLoad& load : loads) {
+            frameAllocator->deallocateFrame(load.frameNumber);
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < loads.size(); ++i) {
+        const PageLoad& load = loads[i];
+        bool faulting = (i == 0);
+        if (load.diskAddress != PageTableEntry::NO_DISK_SLOT) {
+            ++pagesIn;
+        } else if (faulting) {
+            ++zeroFillFaults;
+        }
+        
+        PageTableEntry& entry = space->pageTable[load.pageNumber];
+        entry.present = true;
+        entry.frameNumber = load.frameNumber;
+        mapFrame(load.frameNumber, processId, load.pageNumber);
+        if (faulting) {
+            entry.referenced.store(true, std::memory_order_relaxed);
+            faultedFrames[load.frameNumber].store(true, std::memory_order_relaxed);
+        } else {
+            // Left unreferenced so an unused read-ahead page is the first to go
+            prefetchedFrames[load.frameNumber].store(true, std::memory_order_relaxed);
+            ++prefetchedPages;
+        }
+    }
     
     std::cout << "Page fault handled for process " << processId 
               << ", virtual address 0x" << std::hex << virtualAddr 
-              << ", loaded into frame " << std::dec << frameNumber << std::endl;
+              << ", loaded into frame " << std::dec << loads[0].frameNumber;
+    if (loads.size() > 1) {
+        std::cout << " (+" << loads.size() - 1 << " read ahead)";
+    }
+    std::cout << std::endl;
+}
+
+void VirtualMemoryManager::planReadAhead(AddressSpace& space, int pageNumber, int heldStripe,
+                                         std::vector<PageLoad>& loads, std::vector<std::unique_lock<std::mutex>>& stripeLocks) {
+    // Called with vmMutex held exclusively. A fault one stride after the last
+    // one continues a stream, as does a fault just past the last window, which
+    // means every page read ahead was used: the window doubles.
+    int delta = pageNumber - space.lastFaultPage;
+    bool windowConsumed = (pageNumber == space.expectedFault);
+    bool streaming = windowConsumed || (delta > 0 && delta == space.faultStride);
+    if (windowConsumed) {
+        space.prefetchWindow = std::min(space.prefetchWindow * 2, PREFETCH_MAX_WINDOW);
+    } else if (!streaming) {
+        space.faultStride = (delta > 0 && delta <= PREFETCH_MAX_STRIDE) ? delta : 0;
+    }
+    space.lastFaultPage = pageNumber;
+    if (!streaming) {
+        space.expectedFault = -1;
+        return;
+    }
+    
+    // Read ahead into free frames only; speculation never evicts. Each page's
+    // fault stripe is taken without waiting, so a page someone else is already
+    // faulting in is skipped rather than loaded twice.
+    std::bitset<FAULT_LOCK_STRIPES> heldStripes;
+    heldStripes.set(heldStripe);
+    int stride = space.faultStride;
+    int lastCovered = pageNumber;
+    for (int i = 1; i <= space.prefetchWindow; ++i) {
+        int page = pageNumber + i * stride;
+        if (page >= static_cast<int>(space.pageTable.size())) {
+            break;
+        }
+        PageTableEntry& entry = space.pageTable[page];
+        if (!entry.present) {
+            int stripe = static_cast<int>(makePageKey(space.processId, page) % FAULT_LOCK_STRIPES);
+            if (!heldStripes.test(stripe)) {
+                std::unique_lock<std::mutex> stripeLock(faultLocks[stripe], std::try_to_lock);
+                if (!stripeLock.owns_lock()) {
+                    continue;
+                }
+                stripeLocks.push_back(std::move(stripeLock));
+                heldStripes.set(stripe);
+            }
+            int frameNumber = frameAllocator->allocateFrames(framesPerPage(space));
+            if (frameNumber == -1) {
+                break;
+            }
+            loads.push_back({page, frameNumber, entry.diskAddress});
+        }
+        lastCovered = page;
+    }
+    space.expectedFault = lastCovered + stride;
 }
 
 bool VirtualMemoryManager::isValidMemoryAccess(int processId, uint32_t virtualAddr) const {
-    auto it = processMemorySizes.find(processId);
-    if (it == processMemorySizes.end()) {
-        return false;
+    AddressSpace* space = findAddressSpace(processId);
+    return space && virtualAddr < space->size;
+}
+
+AddressSpace* VirtualMemoryManager::findAddressSpace(int processId) const {
+    if (processId < 0 || processId >= static_cast<int>(slotByPid.size())) {
+        return nullptr;
+    }
+    int slot = slotByPid[processId];
+    return (slot != -1) ? addressSpaces[slot].get() : nullptr;
+}
+
+AddressSpace& VirtualMemoryManager::createAddressSpace(int processId) {
+    // Called with vmMutex held exclusively
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(addressSpaces.size());
+        addressSpaces.push_back(std::make_unique<AddressSpace>());
+    }
+    if (processId >= static_cast<int>(slotByPid.size())) {
+        slotByPid.resize(std::max<size_t>(processId + 1, slotByPid.size() * 2), -1);
     }
+    slotByPid[processId] = slot;
     
-    return virtualAddr < it->second;
+    AddressSpace& space = *addressSpaces[slot];
+    space.processId = processId;
+    space.lastFaultPage = -1;
+    space.faultStride = 0;
+    space.expectedFault = -1;
+    space.prefetchWindow = 2;
+    return space;
+}
+
+void VirtualMemoryManager::releaseAddressSpace(AddressSpace& space) {
+    // Called with vmMutex held exclusively, after every frame and TLB entry of the
+    // process is gone, so nothing still refers to the slot when a pid or slot is
+    // reused. The slot keeps its page table capacity for the next process.
+    int slot = slotByPid[space.processId];
+    slotByPid[space.processId] = -1;
+    space.processId = -1;
+    space.size = 0;
+    space.pageTable.clear();
+    freeSlots.push_back(slot);
 }
 
 VirtualMemoryManager::MemoryStats VirtualMemoryManager::getMemoryStats() const {
@@ -321,80 +904,198 @@ VirtualMemoryManager::MemoryStats VirtualMemoryManager::getMemoryStats() const {
     stats.pageFaults = pageFaults;
     stats.pagesIn = pagesIn;
     stats.pagesOut = pagesOut;
+    stats.zeroFillFaults = zeroFillFaults;
+    stats.prefetchedPages = prefetchedPages;
+    stats.prefetchHits = prefetchHits.load(std::memory_order_relaxed);
+    stats.prefetchWasted = prefetchWasted;
     stats.totalFrames = frameAllocator->getTotalFrames();
     stats.freeFrames = frameAllocator->getAvailableFrameCount();
     stats.usedFrames = stats.totalFrames - stats.freeFrames;
     stats.totalMemory = physicalMemory.size();
-    stats.usedMemory = stats.usedFrames * PAGE_SIZE;
+    stats.usedMemory = stats.usedFrames * pageSize;
     stats.freeMemory = stats.totalMemory - stats.usedMemory;
+    stats.backingStoreSize = backingStore->getFileSize();
+    stats.backingStoreUsed = backingStore->getUsedBytes();
+    stats.tlbHits = 0;
+    stats.tlbMisses = 0;
+    for (const auto& tlb : coreTlbs) {
+        stats.tlbHits += tlb->hits.load(std::memory_order_relaxed);
+        stats.tlbMisses += tlb->misses.load(std::memory_order_relaxed);
+    }
     
     return stats;
 }
 
 // Private helper methods
 int VirtualMemoryManager::getPageNumber(uint32_t virtualAddr) const {
-    return virtualAddr / PAGE_SIZE;
+    return virtualAddr >> pageShift;
 }
 
 int VirtualMemoryManager::getPageOffset(uint32_t virtualAddr) const {
-    return virtualAddr % PAGE_SIZE;
+    return virtualAddr & (pageSize - 1);
 }
 
 uint32_t VirtualMemoryManager::getPhysicalAddress(int frameNumber, int offset) const {
-    return frameNumber * PAGE_SIZE + offset;
+    return (static_cast<uint32_t>(frameNumber) << pageShift) + offset;
 }
 
-int VirtualMemoryManager::selectVictimPage() {
-    // Simple LRU implementation - find page with oldest access time
-    uint64_t oldestTime = UINT64_MAX;
-    int victimProcessId = -1;
-    int victimPageNumber = -1;
-    int victimFrame = -1;
-    
-    for (const auto& [processId, pageTable] : processPageTables) {
-        for (int i = 0; i < pageTable.size(); ++i) {
-            if (pageTable[i].present && pageTable[i].lastAccessTime < oldestTime) {
-                oldestTime = pageTable[i].lastAccessTime;
-                victimProcessId = processId;
-                victimPageNumber = i;
-                victimFrame = pageTable[i].frameNumber;
-            }
+int VirtualMemoryManager::claimFrames(int count) {
+    // Evict until an aligned run of count frames is free. A base page needs
+    // one eviction at most; a huge page may need several, as freed frames
+    // only coalesce once their buddies are free too.
+    while (true) {
+        int frameNumber = frameAllocator->allocateFrames(count);
+        if (frameNumber != -1) {
+            return frameNumber;
+        }
+        
+        int victimFrame = selectVictimPage();
+        if (victimFrame == -1) {
+            return -1;
         }
+        frameAllocator->deallocateFrame(victimFrame);
     }
-    
-    if (victimProcessId != -1) {
-        evictPage(victimProcessId, victimPageNumber);
-        return victimFrame;
+}
+
+int VirtualMemoryManager::selectVictimPage() {
+    // Called with vmMutex held exclusively, so no translation is touching the policy
+    int victimFrame = replacementPolicy->selectVictim([this](int frame) {
+        const FrameInfo& info = frameTable[frame];
+        PageTableEntry& entry = findAddressSpace(info.ownerProcessId)->pageTable[info.pageNumber];
+        return entry.referenced.exchange(false, std::memory_order_relaxed);
+    });
+    if (victimFrame == -1) {
+        return -1;
     }
     
-    return -1;
+    const FrameInfo& info = frameTable[victimFrame];
+    evictPage(info.ownerProcessId, info.pageNumber);
+    unmapFrame(victimFrame, true);
+    return victimFrame;
 }
 
 void VirtualMemoryManager::evictPage(int processId, int pageNumber) {
-    auto& entry = processPageTables[processId][pageNumber];
+    AddressSpace& space = *findAddressSpace(processId);
+    auto& entry = space.pageTable[pageNumber];
+    int blocks = framesPerPage(space);
+    
+    // No core may keep using the frame once it is chosen
+    tlbShootdown(space, pageNumber);
     
-    // If page is dirty, write to backing store
+    // If page is dirty, write to backing store, taking a slot the first time
     if (entry.dirty) {
-        uint8_t* pageData = &physicalMemory[entry.frameNumber * PAGE_SIZE];
-        backingStore->storePage(entry.frameNumber, entry.diskAddress, pageData);
+        if (!entry.hasDiskSlot()) {
+            entry.diskAddress = backingStore->allocateDiskSpace(blocks);
+        }
+        uint8_t* pageData = &physicalMemory[getPhysicalAddress(entry.frameNumber, 0)];
+        backingStore->storePage(entry.diskAddress, pageData, blocks);
         ++pagesOut;
     }
     
     // Mark as not present
     entry.present = false;
     entry.dirty = false;
-    entry.referenced = false;
+    entry.referenced.store(false, std::memory_order_relaxed);
     
     std::cout << "Evicted page " << pageNumber << " from process " << processId << std::endl;
 }
 
-void VirtualMemoryManager::updateAccessTime(PageTableEntry& entry) const {
-    entry.lastAccessTime = ++accessCounter;
-    entry.referenced = true;
+void VirtualMemoryManager::updateAccessTime(PageTableEntry& entry, int coreId) {
+    // Called with vmMutex held shared or exclusive; the bit itself needs no lock
+    entry.referenced.store(true, std::memory_order_relaxed);
+    
+    if (coreId >= 0 && coreId < static_cast<int>(coreTlbs.size())) {
+        Tlb& tlb = *coreTlbs[coreId];
+        std::lock_guard<std::mutex> lock(tlb.mutex);
+        logAccess(tlb, static_cast<int>(entry.frameNumber));
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(policyMutex);
+    replacementPolicy->onAccess(entry.frameNumber);
+}
+
+void VirtualMemoryManager::logAccess(Tlb& tlb, int frameNumber) {
+    // Back-to-back accesses to one page carry no new ordering information
+    if (tlb.accessLogCount > 0 &&
+        tlb.accessLog[(tlb.accessLogStart + tlb.accessLogCount - 1) % ACCESS_LOG_SIZE] == frameNumber) {
+        return;
+    }
+    if (tlb.accessLogCount == ACCESS_LOG_SIZE) {
+        tlb.accessLogStart = (tlb.accessLogStart + 1) % ACCESS_LOG_SIZE;
+        --tlb.accessLogCount;
+    }
+    tlb.accessLog[(tlb.accessLogStart + tlb.accessLogCount) % ACCESS_LOG_SIZE] = frameNumber;
+    ++tlb.accessLogCount;
+}
+
+void VirtualMemoryManager::dropLoggedAccesses(Tlb& tlb, int frameNumber) {
+    // Compacts the ring in place, keeping the remaining accesses in order
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < tlb.accessLogCount; ++i) {
+        int logged = tlb.accessLog[(tlb.accessLogStart + i) % ACCESS_LOG_SIZE];
+        if (logged != frameNumber) {
+            tlb.accessLog[(tlb.accessLogStart + kept) % ACCESS_LOG_SIZE] = logged;
+            ++kept;
+        }
+    }
+    tlb.accessLogCount = kept;
+}
+
+void VirtualMemoryManager::drainAccessLogs() {
+    // A frame's logged hits are dropped when its page is shot down, so every
+    // logged frame still holds the page that was accessed. Policies ignore
+    // frames that are no longer resident.
+    for (auto& tlb : coreTlbs) {
+        std::lock_guard<std::mutex> lock(tlb->mutex);
+        for (uint32_t i = 0; i < tlb->accessLogCount; ++i) {
+            replacementPolicy->onAccess(tlb->accessLog[(tlb->accessLogStart + i) % ACCESS_LOG_SIZE]);
+        }
+        tlb->accessLogStart = 0;
+        tlb->accessLogCount = 0;
+    }
+}
+
+uint64_t VirtualMemoryManager::makePageKey(int processId, int pageNumber) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(processId)) << 32) | static_cast<uint32_t>(pageNumber);
+}
+
+void VirtualMemoryManager::mapFrame(int frameNumber, int processId, int pageNumber) {
+    // Called with vmMutex held exclusively
+    FrameInfo& info = frameTable[frameNumber];
+    info.ownerProcessId = processId;
+    info.pageNumber = pageNumber;
+    replacementPolicy->onLoad(frameNumber, makePageKey(processId, pageNumber));
+}
+
+void VirtualMemoryManager::unmapFrame(int frameNumber, bool evicted) {
+    // Called with vmMutex held exclusively
+    FrameInfo& info = frameTable[frameNumber];
+    if (info.ownerProcessId == -1) {
+        return;
+    }
+    if (evicted) {
+        replacementPolicy->onEvict(frameNumber);
+    } else {
+        replacementPolicy->onRelease(frameNumber);
+    }
+    
+    faultedFrames[frameNumber].store(false, std::memory_order_relaxed);
+    
+    // An untouched read-ahead page was a misprediction; read less next time
+    if (prefetchedFrames[frameNumber].exchange(false, std::memory_order_relaxed)) {
+        ++prefetchWasted;
+        AddressSpace* space = findAddressSpace(info.ownerProcessId);
+        if (space) {
+            space->prefetchWindow = std::max(space->prefetchWindow / 2, PREFETCH_MIN_WINDOW);
+        }
+    }
+    info.ownerProcessId = -1;
+    info.pageNumber = -1;
 }
 
 size_t VirtualMemoryManager::getProcessMemorySize(int processId) const {
     std::shared_lock<std::shared_mutex> lock(vmMutex);
-    auto it = processMemorySizes.find(processId);
-    return it != processMemorySizes.end() ? it->second : 0;
+    AddressSpace* space = findAddressSpace(processId);
+    return space ? space->size : 0;
 }
\ No newline at end of file
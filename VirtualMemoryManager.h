@@ -8,8 +8,12 @@
 #include <shared_mutex>
 #include <stdexcept>
 #include <cstdint>
-#include <queue>
+#include <array>
+#include <atomic>
 #include <fstream>
+#include <string>
+#include "ReplacementPolicy.h"
+#include "BuddyAllocator.h"
 
 // Forward declarations
 class Process;
@@ -30,26 +34,53 @@ public:
     int getProcessId() const { return processId; }
 };
 
-// Page table entry structure
+// Page table entry structure, packed to 12 bytes
 struct PageTableEntry {
-    bool present = false;        // Page is in physical memory
-    bool dirty = false;          // Page has been modified
-    bool referenced = false;     // Page has been accessed (for LRU)
-    uint32_t frameNumber = 0;    // Physical frame number
-    uint32_t diskAddress = 0;    // Address in backing store
+    static constexpr uint32_t NO_DISK_SLOT = UINT32_MAX;
     
-    // For LRU tracking
-    mutable uint64_t lastAccessTime = 0;
+    uint32_t frameNumber : 30;   // Physical frame number
+    uint32_t present : 1;        // Page is in physical memory
+    uint32_t dirty : 1;          // Page has been modified
+    uint32_t diskAddress = NO_DISK_SLOT;  // Address in backing store, assigned on first dirty eviction
+    std::atomic<bool> referenced{false};  // Set lock-free by any core on access, cleared by replacement
     
-    PageTableEntry() = default;
-    PageTableEntry(bool p, uint32_t frame) : present(p), frameNumber(frame) {}
+    PageTableEntry() : frameNumber(0), present(0), dirty(0) {}
+    PageTableEntry(bool p, uint32_t frame) : frameNumber(frame), present(p), dirty(0) {}
+    PageTableEntry(const PageTableEntry& other) { *this = other; }
+    PageTableEntry& operator=(const PageTableEntry& other) {
+        present = other.present;
+        dirty = other.dirty;
+        referenced.store(other.referenced.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        frameNumber = other.frameNumber;
+        diskAddress = other.diskAddress;
+        return *this;
+    }
+    
+    bool hasDiskSlot() const { return diskAddress != NO_DISK_SLOT; }
+};
+
+// Everything the manager knows about one process's virtual memory
+struct AddressSpace {
+    int processId = -1;
+    size_t size = 0;             // Bytes of virtual memory
+    uint32_t baseAddress = 0;    // Virtual addresses start at 0 for each process
+    int pageShift = 0;           // log2 of the page size; above the frame size for huge pages
+    std::vector<PageTableEntry> pageTable;
+    
+    // Read-ahead stream detector, updated with vmMutex held exclusively
+    int lastFaultPage = -1;
+    int faultStride = 0;         // Pages between the last two faults, 0 when not strided
+    int expectedFault = -1;      // First page past the last read-ahead window
+    int prefetchWindow = 2;      // Pages read ahead on the next fault of the stream
 };
 
-// Frame allocator for managing physical memory frames
+// Frame allocator for managing physical memory frames. Frames are handed
+// out as aligned power-of-two runs by a buddy allocator working in frame
+// units, so a huge page gets physically contiguous frames and freeing it
+// coalesces them again.
 class FrameAllocator {
 private:
-    std::vector<bool> frameStatus;  // true = allocated, false = free
-    std::queue<int> freeFrames;
+    BuddyAllocator blocks;
     mutable std::mutex frameMutex;
     int totalFrames;
     int frameSize;
@@ -58,67 +89,205 @@ public:
     FrameAllocator(int totalMemory, int frameSize);
     ~FrameAllocator() = default;
     
-    int allocateFrame();
-    void deallocateFrame(int frameNumber);
+    int allocateFrame() { return allocateFrames(1); }
+    int allocateFrames(int count);          // First frame of an aligned run, or -1
+    void deallocateFrame(int frameNumber);  // Frees the whole run starting there
     bool hasAvailableFrames() const;
     int getAvailableFrameCount() const;
     int getTotalFrames() const { return totalFrames; }
     int getFrameSize() const { return frameSize; }
 };
 
-// Backing store for swapped-out pages
+// Backing store for swapped-out pages. Page-outs collect in a write-back
+// buffer and reach the file as address-ordered runs, one write per run of
+// contiguous pages; page-ins read the buffer first so they always see the
+// latest copy. The file is accessed with pread/pwrite (fstream on Windows).
 class BackingStore {
+public:
+    // When page-outs are forced to stable storage (backing-store-sync)
+    enum class SyncPolicy {
+        NONE,       // Leave it to the OS
+        BATCH,      // fsync after each write-back batch
+        ALWAYS      // Write through and fsync on every page-out
+    };
+    
+    static SyncPolicy parseSyncPolicy(const std::string& name);
+    
 private:
+#ifdef _WIN32
     std::fstream backingFile;
+#else
+    int fd = -1;
+#endif
     mutable std::mutex fileMutex;
     std::string filename;
-    std::map<uint32_t, bool> allocatedBlocks;  // Track allocated disk space
-    uint32_t nextFreeBlock;
     int blockSize;
     
+    // Slot allocation: one bit per page-sized slot, lowest free slot first so
+    // live pages cluster at the front of the file and the tail can be trimmed
+    std::vector<uint64_t> slotBitmap;
+    uint32_t slotLimit = 0;     // One past the highest allocated slot
+    uint32_t usedSlots = 0;
+    uint32_t searchHint = 0;    // No free slot below this index
+    uint64_t fileBytes = 0;     // Current length of the file
+    SyncPolicy syncPolicy;
+    
+    // Write-back buffer: disk address -> page index in pendingData
+    std::map<uint32_t, size_t> pendingPages;
+    std::vector<uint8_t> pendingData;
+    size_t writeBackCapacity;   // Pages buffered before a batch is written
+    
+    void storeBlockLocked(uint32_t diskAddress, const uint8_t* data);
+    void loadBlockLocked(uint32_t diskAddress, uint8_t* data);
+    void releaseSlotLocked(uint32_t slot);
+    bool slotUsed(uint32_t slot) const;
+    void writeAt(uint32_t offset, const uint8_t* data, size_t length);
+    size_t readAt(uint32_t offset, uint8_t* data, size_t length);
+    void syncFile();
+    void flushPendingLocked();
+    
 public:
-    BackingStore(const std::string& filename, int blockSize);
+    BackingStore(const std::string& filename, int blockSize,
+                 size_t writeBackPages = 64, SyncPolicy policy = SyncPolicy::NONE);
     ~BackingStore();
     
-    void storePage(int frameNumber, uint32_t diskAddress, const uint8_t* pageData);
-    void loadPage(uint32_t diskAddress, int frameNumber, uint8_t* pageData);
-    uint32_t allocateDiskSpace();
-    void deallocateDiskSpace(uint32_t diskAddress);
+    // A page spans `blocks` consecutive slots; huge pages use more than one
+    void storePage(uint32_t diskAddress, const uint8_t* pageData, int blocks = 1);
+    void loadPage(uint32_t diskAddress, uint8_t* pageData, int blocks = 1);
+    uint32_t allocateDiskSpace(int blocks = 1);
+    void deallocateDiskSpace(uint32_t diskAddress, int blocks = 1);
     void initialize();
+    
+    // Write every buffered page out now
+    void flush();
+    
+    // Truncate the file after the highest allocated slot
+    void compact();
+    
+    // True once the file has grown to more than twice the space its live slots need
+    bool shouldCompact() const;
+    
+    uint64_t getFileSize() const;
+    uint64_t getUsedBytes() const;
 };
 
 // Main Virtual Memory Manager
 class VirtualMemoryManager {
 private:
-    static constexpr int PAGE_SIZE = 16;           // 16 bytes per page (as per config)
     static constexpr int SYMBOL_TABLE_SIZE = 64;   // 64 bytes for variables
+    static constexpr int FAULT_RETRY_LIMIT = 8;    // Faults per access before giving up under thrashing
+    
+    // Read-ahead window bounds, and the largest stride still treated as one stream
+    static constexpr int PREFETCH_MIN_WINDOW = 1;
+    static constexpr int PREFETCH_MAX_WINDOW = 16;
+    static constexpr int PREFETCH_MAX_STRIDE = 8;
     
-    // Page tables for each process (processId -> page table)
-    std::map<int, std::vector<PageTableEntry>> processPageTables;
+    // Address spaces live in a recycled slot array; slotByPid maps a pid
+    // straight to its slot, so pid -> page table entry is a direct index
+    std::vector<std::unique_ptr<AddressSpace>> addressSpaces;
+    std::vector<int> freeSlots;
+    std::vector<int> slotByPid;     // -1 when the pid has no memory
     
     // Physical memory representation (frame-based)
     std::vector<uint8_t> physicalMemory;
     
+    // Pages are mem-per-frame bytes, a power of two, so address math is shift and mask.
+    // Processes of at least hugePageThreshold bytes use pages of 1 << hugePageShift.
+    int pageSize;
+    int pageShift;
+    int hugePageShift = 0;          // 0 when huge pages are off
+    size_t hugePageThreshold = 0;
+    
+    // Reverse map entry for a physical frame
+    struct FrameInfo {
+        int ownerProcessId = -1;    // -1 when the frame holds no page
+        int pageNumber = -1;
+    };
+    
+    // Frame-indexed reverse map, so eviction never searches page tables
+    std::vector<FrameInfo> frameTable;
+    
+    // Set while a frame holds a read-ahead page that has not been accessed yet.
+    // Cleared by the first translation (under a shared lock) or when unmapped.
+    std::vector<std::atomic<bool>> prefetchedFrames;
+    
+    // Set when a fault maps a frame. The access that raised the fault is the
+    // page's first reference, already counted by onLoad, so its retry clears
+    // this instead of reporting a hit that would promote the page.
+    std::vector<std::atomic<bool>> faultedFrames;
+    
+    // One page brought in by a fault: the faulting page, or read-ahead behind it
+    struct PageLoad {
+        int pageNumber;
+        int frameNumber;
+        uint32_t diskAddress;
+    };
+    
+    bool compactBackingStore = true;    // Trim the swap file when processes release memory
+    
+    // Victim selection (page-replacement-alg)
+    std::unique_ptr<ReplacementPolicy> replacementPolicy;
+    std::mutex policyMutex;     // Serializes hit notifications from callers without a core
+    
+    // Per-core software TLB, direct mapped. A hit does the access holding only the
+    // core's own mutex; evictions and deallocation shoot entries down through the
+    // same mutex, so a frame is never reused while a hit is still touching it.
+    // Lock order is vmMutex before any TLB mutex.
+    static constexpr int TLB_ENTRIES = 16;
+    static constexpr int ACCESS_LOG_SIZE = 64;
+    
+    struct TlbEntry {
+        int processId = -1;         // -1 when the slot is empty
+        int pageNumber = -1;
+        uint32_t frameNumber = 0;
+        uint32_t pageFrame = 0;     // First frame of a huge page, what the policy tracks
+        uint32_t processSize = 0;   // Bound for the offset check on a hit
+        bool dirty = false;         // Clean entries fall back to the slow path on write
+        PageTableEntry* pte = nullptr;
+    };
+    
+    struct alignas(64) Tlb {
+        std::mutex mutex;
+        std::array<TlbEntry, TLB_ENTRIES> entries;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        
+        // Frames this core touched since the last drain, oldest first. Hits
+        // are reported to the policy in batches instead of through a shared
+        // lock; when the ring wraps, the oldest accesses are dropped.
+        std::array<int, ACCESS_LOG_SIZE> accessLog;
+        uint32_t accessLogStart = 0;
+        uint32_t accessLogCount = 0;
+    };
+    
+    std::vector<std::unique_ptr<Tlb>> coreTlbs;
+    
     // Components
     std::unique_ptr<FrameAllocator> frameAllocator;
     std::unique_ptr<BackingStore> backingStore;
     
     // Synchronization
     mutable std::shared_mutex vmMutex;  // Allows multiple readers for address translation
-    mutable std::mutex pageFaultMutex;  // Exclusive for page fault handling
+    
+    // Faults on the same page serialize on its stripe; faults on different pages
+    // only share the short vmMutex sections before and after the disk read.
+    // Lock order is fault stripe before vmMutex.
+    static constexpr int FAULT_LOCK_STRIPES = 64;
+    std::array<std::mutex, FAULT_LOCK_STRIPES> faultLocks;
     
     // Statistics
     uint64_t pageFaults = 0;
     uint64_t pagesIn = 0;
     uint64_t pagesOut = 0;
-    mutable uint64_t accessCounter = 0;  // For LRU tracking
-    
-    // Process memory tracking
-    std::map<int, size_t> processMemorySizes;
-    std::map<int, uint32_t> processBaseAddresses;
+    uint64_t zeroFillFaults = 0;  // First-touch faults served without I/O
+    uint64_t prefetchedPages = 0;
+    std::atomic<uint64_t> prefetchHits{0};
+    uint64_t prefetchWasted = 0;  // Read ahead, then evicted or released untouched
     
 public:
-    VirtualMemoryManager(int totalPhysicalMemory = 16384, int frameSize = 16);
+    VirtualMemoryManager(int totalPhysicalMemory = 16384, int frameSize = 16,
+                         const std::string& replacementAlg = "LRU",
+                         const std::string& backingStoreSync = "none");
     ~VirtualMemoryManager();
     
     // Core virtual memory operations
@@ -127,10 +296,29 @@ public:
     
     // Address translation and memory access
     bool translateAddress(int processId, uint32_t virtualAddr, uint32_t& physicalAddr);
-    uint16_t readMemory(int processId, uint32_t virtualAddr);
-    void writeMemory(int processId, uint32_t virtualAddr, uint16_t value);
     
-    // Page fault handling
+    // coreId selects the TLB to go through; -1 always takes the locked page-table path
+    uint16_t readMemory(int processId, uint32_t virtualAddr, int coreId = -1);
+    void writeMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId = -1);
+    
+    // One TLB per core; existing entries are discarded
+    void setCoreCount(int cores);
+    
+    // backing-store-compact
+    void setBackingStoreCompaction(bool enabled);
+    
+    // huge-page-size and huge-page-threshold; a size of 0 turns huge pages off.
+    // Applies to processes allocated afterwards.
+    void setHugePages(int hugePageSize, size_t threshold);
+    int getPageSize() const { return pageSize; }
+    
+    // Non-blocking access for the Scheduler: false means the page is not resident
+    // and the caller should get handlePageFault run (off the core) and retry.
+    // Addresses outside the process still throw PageFaultException.
+    bool tryReadMemory(int processId, uint32_t virtualAddr, uint16_t& value, int coreId = -1);
+    bool tryWriteMemory(int processId, uint32_t virtualAddr, uint16_t value, int coreId = -1);
+    
+    // Page fault handling; blocks for the disk read, safe to run on any thread
     void handlePageFault(int processId, uint32_t virtualAddr);
     
     // Memory validation
@@ -141,15 +329,24 @@ public:
         uint64_t pageFaults;
         uint64_t pagesIn;
         uint64_t pagesOut;
+        uint64_t zeroFillFaults;
+        uint64_t prefetchedPages;
+        uint64_t prefetchHits;
+        uint64_t prefetchWasted;
         int totalFrames;
         int freeFrames;
         int usedFrames;
         size_t totalMemory;
         size_t usedMemory;
         size_t freeMemory;
+        uint64_t tlbHits;
+        uint64_t tlbMisses;
+        uint64_t backingStoreSize;   // Bytes on disk
+        uint64_t backingStoreUsed;   // Bytes in allocated slots
     };
     
     MemoryStats getMemoryStats() const;
+    const char* getReplacementPolicyName() const { return replacementPolicy->getName(); }
     void resetStats();
     
     // Process memory information
@@ -162,14 +359,46 @@ public:
     
 private:
     // Internal helper methods
-    int getPageNumber(uint32_t virtualAddr) const;
+    AddressSpace* findAddressSpace(int processId) const;
+    AddressSpace& createAddressSpace(int processId);
+    void releaseAddressSpace(AddressSpace& space);
+    int getPageNumber(uint32_t virtualAddr) const;      // Frame-sized page, the TLB's unit
     int getPageOffset(uint32_t virtualAddr) const;
+    static int spacePage(const AddressSpace& space, uint32_t virtualAddr) { return virtualAddr >> space.pageShift; }
+    int framesPerPage(const AddressSpace& space) const { return 1 << (space.pageShift - pageShift); }
     uint32_t getPhysicalAddress(int frameNumber, int offset) const;
     
-    // Page replacement (LRU)
+    // Translation with vmMutex already held; the entry of a resident page, or nullptr
+    PageTableEntry* translateLocked(int processId, uint32_t virtualAddr, uint32_t& physicalAddr, int coreId = -1);
+    
+    // One access through the page table, bypassing the TLB; false if the page is not resident
+    bool pageTableAccess(int processId, uint32_t virtualAddr, bool isWrite, uint16_t& value, int coreId);
+    
+    // TLB maintenance
+    static int tlbSlot(int processId, int pageNumber);
+    bool tlbAccess(int coreId, int processId, uint32_t virtualAddr, bool isWrite, uint16_t& value);
+    void tlbFill(int coreId, int processId, uint32_t virtualAddr, PageTableEntry& entry);
+    void tlbShootdown(const AddressSpace& space, int pageNumber);  // Every frame-sized page of it
+    
+    // Little-endian 16-bit access to physical memory
+    uint16_t loadWord(uint32_t physicalAddr) const;
+    void storeWord(uint32_t physicalAddr, uint16_t value);
+    
+    // Page replacement
+    int claimFrames(int count);   // A free or freshly evicted aligned run, requires vmMutex held exclusively
+    void planReadAhead(AddressSpace& space, int pageNumber, int heldStripe,
+                       std::vector<PageLoad>& loads, std::vector<std::unique_lock<std::mutex>>& stripeLocks);
     int selectVictimPage();
     void evictPage(int victimProcessId, int victimPageNumber);
-    void updateAccessTime(PageTableEntry& entry) const;
+    void updateAccessTime(PageTableEntry& entry, int coreId);
+    void logAccess(Tlb& tlb, int frameNumber);   // Requires tlb.mutex
+    void dropLoggedAccesses(Tlb& tlb, int frameNumber);  // Requires tlb.mutex
+    void drainAccessLogs();                     // Requires vmMutex held exclusively
+    
+    // Reverse map maintenance; both report the residency change to the policy
+    static uint64_t makePageKey(int processId, int pageNumber);
+    void mapFrame(int frameNumber, int processId, int pageNumber);
+    void unmapFrame(int frameNumber, bool evicted);
     
     // Page loading and storing
     void loadPageFromDisk(int processId, int pageNumber);
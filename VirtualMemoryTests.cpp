@@ -4,6 +4,9 @@
 #include <cassert>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <random>
+#include <algorithm>
 
 class VirtualMemoryTester {
 private:
@@ -25,6 +28,13 @@ public:
         testMemoryAccess();
         testPageReplacement();
         testMemoryStats();
+        testReplacementPolicies();
+        testTlb();
+        testBackingStoreReuse();
+        testZeroFillFaults();
+        testAsyncFaults();
+        testReadAhead();
+        testHugePages();
         
         std::cout << "=== All Tests Completed ===" << std::endl;
     }
@@ -243,6 +253,261 @@ private:
         std::cout << "✓ Memory statistics are consistent" << std::endl;
         std::cout << "Test 7 PASSED" << std::endl;
     }
+    
+    void testReplacementPolicies() {
+        std::cout << "\n--- Test 8: Replacement Policies ---" << std::endl;
+        
+        // A hot page revisited between sweeps over a working set larger than memory
+        for (const char* alg : {"LRU", "FIFO", "CLOCK", "SECOND-CHANCE", "LFU", "ARC"}) {
+            VirtualMemoryManager vm(128, 16, alg); // 8 frames
+            vm.allocateVirtualMemory(1, 256);     // 16 pages
+            
+            for (int round = 0; round < 3; ++round) {
+                for (uint32_t addr = 0; addr < 256; addr += 16) {
+                    vm.writeMemory(1, addr, static_cast<uint16_t>(addr));
+                    vm.writeMemory(1, 0, 0xBEEF);
+                }
+            }
+            
+            // Every page must read back what was last written, wherever it was evicted to
+            for (uint32_t addr = 16; addr < 256; addr += 16) {
+                assert(vm.readMemory(1, addr) == addr && "Page contents lost across eviction");
+            }
+            assert(vm.readMemory(1, 0) == 0xBEEF && "Hot page contents lost");
+            
+            auto stats = vm.getMemoryStats();
+            assert(stats.pagesOut > 0 && "Working set exceeds memory, pages must be written out");
+            assert(stats.usedFrames == stats.totalFrames && "All frames should be resident");
+            std::cout << "✓ " << vm.getReplacementPolicyName() << ": " << stats.pageFaults << " page faults" << std::endl;
+            
+            vm.deallocateVirtualMemory(1);
+            assert(vm.getMemoryStats().freeFrames == stats.totalFrames && "Frames should be released");
+        }
+        
+        // A hot set read twice a round between shuffled one-off reads of cold
+        // pages: ARC keeps the hot set in T2 while the scan churns T1, LRU does not
+        uint64_t faults[2];
+        const char* scanAlgs[2] = {"LRU", "ARC"};
+        for (int a = 0; a < 2; ++a) {
+            VirtualMemoryManager vm(256, 16, scanAlgs[a]); // 16 frames
+            vm.allocateVirtualMemory(1, 1024);             // 64 pages
+            std::mt19937 rng(7);
+            std::vector<uint32_t> coldPages;
+            for (uint32_t page = 8; page < 64; ++page) {
+                coldPages.push_back(page);
+            }
+            for (int round = 0; round < 200; ++round) {
+                for (int pass = 0; pass < 2; ++pass) {
+                    for (uint32_t page = 0; page < 8; ++page) {
+                        vm.readMemory(1, page * 16);
+                    }
+                }
+                std::shuffle(coldPages.begin(), coldPages.end(), rng);
+                for (int i = 0; i < 12; ++i) {
+                    vm.readMemory(1, coldPages[i] * 16);
+                }
+            }
+            faults[a] = vm.getMemoryStats().pageFaults;
+            vm.deallocateVirtualMemory(1);
+        }
+        std::cout << "✓ Scan workload: LRU " << faults[0] << " faults, ARC " << faults[1] << " faults" << std::endl;
+        assert(faults[1] < faults[0] && "ARC should resist a scan that flushes LRU");
+        
+        std::cout << "Test 8 PASSED" << std::endl;
+    }
+    
+    void testTlb() {
+        std::cout << "\n--- Test 9: Per-core TLB ---" << std::endl;
+        
+        VirtualMemoryManager vm(64, 16); // 4 frames
+        vm.setCoreCount(2);
+        vm.allocateVirtualMemory(1, 128);
+        
+        vm.writeMemory(1, 0, 7, 0);     // Miss, fault, fill
+        assert(vm.readMemory(1, 0, 0) == 7);
+        vm.writeMemory(1, 2, 8, 0);     // Dirty entry, hit
+        assert(vm.readMemory(1, 2, 1) == 8 && "Other core misses but reads the same frame");
+        
+        auto stats = vm.getMemoryStats();
+        assert(stats.tlbHits == 2 && stats.tlbMisses == 2);
+        
+        // Push page 0 out; core 0 must not keep hitting the old frame
+        for (uint32_t addr = 16; addr < 128; addr += 16) {
+            vm.writeMemory(1, addr, static_cast<uint16_t>(addr), 1);
+        }
+        assert(vm.readMemory(1, 0, 0) == 7 && "Evicted page must be shot down and reloaded");
+        assert(vm.readMemory(1, 2, 0) == 8);
+        
+        stats = vm.getMemoryStats();
+        std::cout << "✓ TLB hits: " << stats.tlbHits << ", misses: " << stats.tlbMisses << std::endl;
+        std::cout << "Test 9 PASSED" << std::endl;
+    }
+    
+    void testBackingStoreReuse() {
+        std::cout << "\n--- Test 10: Backing Store Slot Reuse ---" << std::endl;
+        
+        VirtualMemoryManager vm(64, 16); // 4 frames
+        
+        // Many short-lived processes, each paging its whole image out
+        for (int pid = 1; pid <= 50; ++pid) {
+            vm.allocateVirtualMemory(pid, 256);
+            for (uint32_t addr = 0; addr < 256; addr += 16) {
+                vm.writeMemory(pid, addr, static_cast<uint16_t>(pid));
+            }
+            for (uint32_t addr = 0; addr < 256; addr += 16) {
+                assert(vm.readMemory(pid, addr) == pid && "Reused slot returned another process's data");
+            }
+            vm.deallocateVirtualMemory(pid);
+        }
+        
+        auto stats = vm.getMemoryStats();
+        std::cout << "Swap file: " << stats.backingStoreSize << " bytes, used: " << stats.backingStoreUsed << std::endl;
+        assert(stats.backingStoreUsed == 0 && "All slots should be free");
+        assert(stats.backingStoreSize <= 2 * 256 && "Freed slots should be reused instead of growing the file");
+        
+        std::cout << "Test 10 PASSED" << std::endl;
+    }
+    
+    void testZeroFillFaults() {
+        std::cout << "\n--- Test 11: Lazy Backing Store and Zero-fill Faults ---" << std::endl;
+        
+        VirtualMemoryManager vm(64, 16); // 4 frames
+        vm.allocateVirtualMemory(1, 4096);
+        
+        // Sparse reads only: every fault is a first touch and nothing is dirty
+        for (uint32_t addr = 0; addr < 4096; addr += 256) {
+            assert(vm.readMemory(1, addr) == 0 && "Untouched memory should read as zero");
+        }
+        
+        auto stats = vm.getMemoryStats();
+        assert(stats.zeroFillFaults == stats.pageFaults && "First-touch faults should not read the backing store");
+        assert(stats.pagesIn == 0 && stats.pagesOut == 0);
+        assert(stats.backingStoreUsed == 0 && "Clean pages should never take a disk slot");
+        
+        // A dirty page takes a slot when it is evicted and reads back from it
+        vm.writeMemory(1, 0, 0xBEEF);
+        for (uint32_t addr = 1024; addr < 2048; addr += 16) {
+            vm.readMemory(1, addr);
+        }
+        assert(vm.readMemory(1, 0) == 0xBEEF && "Evicted dirty page should be restored");
+        
+        stats = vm.getMemoryStats();
+        std::cout << "Zero-fill faults: " << stats.zeroFillFaults << ", pages in: " << stats.pagesIn
+                  << ", swap used: " << stats.backingStoreUsed << " bytes" << std::endl;
+        assert(stats.pagesIn == 1 && stats.backingStoreUsed == 16 && "Only the dirtied page should own a slot");
+        
+        std::cout << "Test 11 PASSED" << std::endl;
+    }
+    
+    void testAsyncFaults() {
+        std::cout << "\n--- Test 12: Non-blocking Access and Concurrent Faults ---" << std::endl;
+        
+        VirtualMemoryManager vm(128, 16); // 8 frames
+        vm.setCoreCount(2);
+        vm.allocateVirtualMemory(1, 256);
+        
+        // The Scheduler path reports a fault instead of servicing it
+        uint16_t value = 0;
+        assert(!vm.tryWriteMemory(1, 0x20, 7, 0) && "Non-resident page should report a fault");
+        
+        // Faults on different pages are serviced from other threads at once
+        std::vector<std::thread> ioThreads;
+        for (uint32_t addr = 0; addr < 128; addr += 16) {
+            ioThreads.emplace_back([&vm, addr] { vm.handlePageFault(1, addr); });
+        }
+        for (auto& thread : ioThreads) {
+            thread.join();
+        }
+        auto stats = vm.getMemoryStats();
+        assert(stats.pageFaults + stats.prefetchedPages == 8 && "Each page should be loaded exactly once");
+        
+        assert(vm.tryWriteMemory(1, 0x20, 7, 0) && vm.tryReadMemory(1, 0x20, value, 1) && value == 7);
+        
+        bool threw = false;
+        try {
+            vm.tryReadMemory(1, 0x400, value, 0);
+        } catch (const PageFaultException&) {
+            threw = true;
+        }
+        assert(threw && "Addresses outside the process are not faults to service");
+        
+        std::cout << "Test 12 PASSED" << std::endl;
+    }
+    
+    void testReadAhead() {
+        std::cout << "\n--- Test 13: Sequential Read-ahead ---" << std::endl;
+        
+        VirtualMemoryManager vm(1024, 16); // 64 frames, nothing is evicted
+        vm.allocateVirtualMemory(1, 1024); // 64 pages
+        
+        // A forward sweep, one word per page
+        for (uint32_t addr = 0; addr < 1024; addr += 16) {
+            vm.writeMemory(1, addr, static_cast<uint16_t>(addr));
+        }
+        for (uint32_t addr = 0; addr < 1024; addr += 16) {
+            assert(vm.readMemory(1, addr) == addr && "Read-ahead must not disturb page contents");
+        }
+        
+        auto stats = vm.getMemoryStats();
+        std::cout << "Faults: " << stats.pageFaults << ", read ahead: " << stats.prefetchedPages
+                  << ", hits: " << stats.prefetchHits << ", wasted: " << stats.prefetchWasted << std::endl;
+        assert(stats.pageFaults < 16 && "A sequential sweep should not fault on every page");
+        assert(stats.pageFaults + stats.prefetchedPages == 64 && "Every page is loaded exactly once");
+        assert(stats.prefetchHits == stats.prefetchedPages && stats.prefetchWasted == 0);
+        
+        // A strided sweep is detected the same way
+        VirtualMemoryManager strided(1024, 16);
+        strided.allocateVirtualMemory(1, 1024);
+        for (uint32_t addr = 0; addr < 1024; addr += 64) {
+            strided.readMemory(1, addr);
+        }
+        stats = strided.getMemoryStats();
+        assert(stats.pageFaults < 16 && stats.prefetchHits > 0 && "A 4-page stride should be read ahead");
+        
+        std::cout << "Test 13 PASSED" << std::endl;
+    }
+    
+    void testHugePages() {
+        std::cout << "\n--- Test 14: Huge Pages ---" << std::endl;
+        
+        VirtualMemoryManager vm(1024, 16); // 64 frames
+        vm.setCoreCount(1);
+        vm.setHugePages(256, 512);         // 16-frame pages for processes of 512 bytes and up
+        vm.allocateVirtualMemory(1, 1024); // 4 huge pages, all of memory
+        vm.allocateVirtualMemory(2, 128);  // Below the threshold: 8 base pages
+        
+        // Every word of the large process, through the TLB
+        for (uint32_t addr = 0; addr < 1024; addr += 2) {
+            vm.writeMemory(1, addr, static_cast<uint16_t>(addr ^ 0x5A5A), 0);
+        }
+        auto stats = vm.getMemoryStats();
+        assert(stats.pageFaults + stats.prefetchedPages == 4 && "A huge page should fault in once");
+        
+        // The small process forces a whole huge page out, then it comes back from swap
+        for (uint32_t addr = 0; addr < 128; addr += 16) {
+            vm.writeMemory(2, addr, static_cast<uint16_t>(addr + 1), 0);
+        }
+        for (uint32_t addr = 0; addr < 1024; addr += 2) {
+            assert(vm.readMemory(1, addr, 0) == static_cast<uint16_t>(addr ^ 0x5A5A) &&
+                   "Huge page contents must survive eviction");
+        }
+        for (uint32_t addr = 0; addr < 128; addr += 16) {
+            assert(vm.readMemory(2, addr, 0) == addr + 1 && "Base pages must survive alongside huge pages");
+        }
+        
+        stats = vm.getMemoryStats();
+        std::cout << "Faults: " << stats.pageFaults << ", pages out: " << stats.pagesOut
+                  << ", swap used: " << stats.backingStoreUsed << " bytes" << std::endl;
+        assert(stats.pagesOut > 0 && stats.pagesIn > 0);
+        
+        // Freeing the huge pages coalesces their frames again
+        vm.deallocateVirtualMemory(1);
+        vm.deallocateVirtualMemory(2);
+        stats = vm.getMemoryStats();
+        assert(stats.freeFrames == 64 && stats.backingStoreUsed == 0 && "All frames and slots should be returned");
+        
+        std::cout << "Test 14 PASSED" << std::endl;
+    }
 };
 
 // Simple test runner
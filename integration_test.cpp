@@ -1,12 +1,17 @@
 #include "VirtualMemoryManager.h"
 #include "ProcessManager.h"
 #include "ConsoleManager.h"
+#include "ProcessGenerator.h"
+#include "InstructionGenerator.h"
 #include <iostream>
 #include <cassert>
 #include <vector>
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <string>
 
 class IntegrationTester {
 private:
@@ -40,6 +45,9 @@ public:
         testMemoryOperations();
         testSchedulerIntegration();
         testStatisticsCollection();
+        testAdmissionQueue();
+        testProcessTable();
+        testBatchArrivals();
         
         std::cout << "=== All Integration Tests Completed ===" << std::endl;
     }
@@ -102,6 +110,21 @@ private:
             std::cout << "✓ Memory operations triggered page faults as expected: " << e.what() << std::endl;
         }
         
+        // Generated programs address only their own memory, and only when given a size
+        InstructionGenerator generator;
+        int memoryOps = 0;
+        for (const auto& instruction : generator.generateRandomInstructions("gen_mem", 200, 200, 256)) {
+            for (size_t at = instruction.find("0x"); at != std::string::npos; at = instruction.find("0x", at + 2)) {
+                assert(std::stoul(instruction.substr(at), nullptr, 16) < 256 && "Generated addresses should stay in the process");
+                memoryOps++;
+            }
+        }
+        assert(memoryOps > 0 && "Generated programs should READ and WRITE");
+        for (const auto& instruction : generator.generateRandomInstructions("gen_flat", 200, 200)) {
+            assert(instruction.find("READ(") == std::string::npos && instruction.find("WRITE(") == std::string::npos);
+        }
+        std::cout << "✓ Generated READ/WRITE stay within the process's memory" << std::endl;
+        
         std::cout << "Integration Test 2 PASSED" << std::endl;
     }
     
@@ -122,10 +145,43 @@ private:
         std::cout << "✓ Total processes: " << allProcs.size() << std::endl;
         std::cout << "✓ Running processes: " << runningProcs.size() << std::endl;
         
+        // One occupancy slot per core, and a process holds at most one core
+        auto occupancy = processManager->getCoreOccupancy();
+        assert(static_cast<int>(occupancy.size()) == processManager->getNumCores());
+        for (size_t i = 0; i < occupancy.size(); ++i) {
+            for (size_t j = i + 1; j < occupancy.size(); ++j) {
+                assert((occupancy[i].processId == -1 || occupancy[i].processId != occupancy[j].processId) &&
+                       "A process should occupy at most one core");
+            }
+        }
+        std::cout << "✓ Cores in use: " << processManager->getUsedCores() << " of " << processManager->getNumCores() << std::endl;
+        
         // Stop the scheduler
         processManager->stopScheduler();
         std::cout << "✓ Scheduler stopped successfully" << std::endl;
         
+        // Halting FCFS cores mid-process leaves no core occupied
+        ProcessManager fcfs;
+        Config config;
+        config.scheduler = "fcfs";
+        config.cpuTickMs = 1;
+        config.isValid = true;
+        fcfs.setConfig(config);
+        fcfs.setMemorySnapshotsEnabled(false);
+        fcfs.startScheduler();
+        std::vector<std::shared_ptr<Process>> longRunning;
+        for (int i = 0; i < config.numCpu; ++i) {
+            longRunning.push_back(std::make_shared<Process>("halt" + std::to_string(i), fcfs.nextProcessId()));
+            longRunning.back()->setInstructions(std::vector<std::string>(5000, "ADD(x, x, 1)"));
+        }
+        fcfs.addGeneratedProcesses(longRunning);
+        for (int wait = 0; wait < 200 && fcfs.getUsedCores() < config.numCpu; ++wait) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        fcfs.haltScheduler();
+        assert(fcfs.getUsedCores() == 0 && longRunning[0]->getIsActive() && "Halted processes should leave their cores");
+        std::cout << "✓ Halted processes release their cores" << std::endl;
+        
         std::cout << "Integration Test 3 PASSED" << std::endl;
     }
     
@@ -145,15 +201,179 @@ private:
         std::cout << "  Pages Out: " << stats.pagesOut << std::endl;
         std::cout << "  Running Processes: " << stats.runningProcessCount << std::endl;
         std::cout << "  Total Processes: " << stats.totalProcessCount << std::endl;
+        std::cout << "  CPU Ticks: " << stats.activeCpuTicks << " busy, " << stats.idleCpuTicks << " idle, "
+                  << stats.instructionsRetired << " instructions" << std::endl;
         
         // Validate statistics consistency
         assert(stats.totalMemory > 0 && "Total memory should be positive");
         assert(stats.totalMemory >= stats.usedMemory && "Used memory should not exceed total");
         assert(stats.totalProcessCount >= stats.runningProcessCount && "Running processes should not exceed total");
+        assert(stats.totalCpuTicks > 0 && stats.totalCpuTicks == stats.activeCpuTicks + stats.idleCpuTicks);
+        assert(stats.instructionsRetired <= stats.activeCpuTicks && "Every retired instruction costs a busy tick");
         
         std::cout << "✓ Statistics are consistent and valid" << std::endl;
         std::cout << "Integration Test 4 PASSED" << std::endl;
     }
+    
+    void testAdmissionQueue() {
+        std::cout << "\n--- Integration Test 5: Admission Queue ---" << std::endl;
+        
+        // Flat memory with room for two processes
+        ProcessManager manager;
+        Config config;
+        config.maxOverallMem = 1024;
+        config.memPerProc = 512;
+        config.minMemPerProc = 512;
+        config.admissionPolicy = "priority";
+        config.isValid = true;
+        manager.setConfig(config);
+        manager.setMemorySnapshotsEnabled(false);
+        
+        std::vector<std::shared_ptr<Process>> batch;
+        for (int i = 0; i < 4; ++i) {
+            batch.push_back(std::make_shared<Process>("adm" + std::to_string(i), 9000 + i));
+        }
+        batch[3]->setPriority(5);
+        for (auto& process : batch) {
+            manager.addGeneratedProcess(process);
+        }
+        assert(manager.getAdmissionQueueLength() == 2 && "Two processes should wait for memory");
+        std::cout << "✓ Processes that do not fit wait in the admission queue" << std::endl;
+        
+        // Each release admits the next waiter, highest priority first
+        manager.releaseProcessMemory(batch[0]);
+        assert(batch[3]->getHasMemoryAllocated() && !batch[2]->getHasMemoryAllocated());
+        manager.releaseProcessMemory(batch[1]);
+        assert(batch[2]->getHasMemoryAllocated() && manager.getAdmissionQueueLength() == 0);
+        std::cout << "✓ Released memory admits waiting processes in priority order" << std::endl;
+        
+        // Under smallest-first a small later arrival overtakes a large earlier one
+        ProcessManager smallest;
+        config.admissionPolicy = "smallest";
+        smallest.setConfig(config);
+        smallest.setMemorySnapshotsEnabled(false);
+        std::vector<std::shared_ptr<Process>> sized;
+        for (int size : {1024, 1024, 256}) {
+            sized.push_back(std::make_shared<Process>("sz" + std::to_string(sized.size()), smallest.nextProcessId()));
+            sized.back()->setMemorySize(size);
+            smallest.addGeneratedProcess(sized.back());
+        }
+        assert(sized[0]->getHasMemoryAllocated() && smallest.getAdmissionQueueLength() == 2);
+        smallest.releaseProcessMemory(sized[0]);
+        assert(sized[2]->getHasMemoryAllocated() && !sized[1]->getHasMemoryAllocated());
+        assert(smallest.getDetailedStats().usedMemory == 256 && "Only the requested size is allocated");
+        std::cout << "✓ Smallest-first admits a smaller later arrival ahead of a larger one" << std::endl;
+        
+        // Generated processes carry their own request and priority
+        ProcessGenerator generator(&smallest);
+        generator.setMemoryRange(128, 2048);
+        for (int i = 0; i < 20; ++i) {
+            auto process = generator.createDummyProcess();
+            int size = process->getMemorySize();
+            assert(size >= 128 && size <= 2048 && (size & (size - 1)) == 0);
+            assert(process->getPriority() >= 0 && process->getPriority() < 10);
+        }
+        std::cout << "✓ Generated processes request a power-of-two size within range" << std::endl;
+        
+        std::cout << "Integration Test 5 PASSED" << std::endl;
+    }
+    
+    void testProcessTable() {
+        std::cout << "\n--- Integration Test 6: Process Table ---" << std::endl;
+        
+        ProcessManager manager;
+        Config config;
+        config.isValid = true;
+        manager.setConfig(config);
+        manager.setMemorySnapshotsEnabled(false);
+        manager.setFinishedHistoryLimit(2);
+        
+        std::vector<std::shared_ptr<Process>> batch;
+        for (int i = 0; i < 3; ++i) {
+            batch.push_back(std::make_shared<Process>("tbl" + std::to_string(i), manager.nextProcessId()));
+            manager.addGeneratedProcess(batch.back());
+        }
+        assert(manager.findProcessByName("tbl1") == batch[1] && manager.findProcessById(batch[2]->getProcessId()) == batch[2]);
+        std::cout << "✓ Processes are found by name and pid" << std::endl;
+        
+        // Finished processes leave the running set; the oldest age out of the table
+        for (auto& process : batch) {
+            process->setActive(false);
+            manager.onProcessFinished(process);
+        }
+        assert(manager.getRunningProcesses().empty() && manager.getFinishedProcesses().size() == 2);
+        assert(!manager.findProcessByName("tbl0") && manager.findProcessByName("tbl2") == batch[2]);
+        assert(manager.getDetailedStats().totalProcessCount == 3 && "Aged-out processes still count");
+        std::cout << "✓ Finished history is bounded" << std::endl;
+        
+        std::cout << "Integration Test 6 PASSED" << std::endl;
+    }
+    
+    void testBatchArrivals() {
+        std::cout << "\n--- Integration Test 7: Batch Arrivals ---" << std::endl;
+        
+        // Room for eight processes across four cores
+        ProcessManager manager;
+        Config config;
+        config.numCpu = 4;
+        config.maxOverallMem = 4096;
+        config.memPerProc = 512;
+        config.minMemPerProc = 512;
+        config.isValid = true;
+        manager.setConfig(config);
+        manager.setMemorySnapshotsEnabled(false);
+        
+        std::vector<std::shared_ptr<Process>> batch;
+        for (int i = 0; i < 10; ++i) {
+            batch.push_back(std::make_shared<Process>("bat" + std::to_string(i), manager.nextProcessId()));
+        }
+        manager.addGeneratedProcesses(batch);
+        
+        auto stats = manager.getDetailedStats();
+        assert(stats.admissionQueueLength == 2 && stats.queuedProcessCount == 8);
+        assert(manager.findProcessByName("bat9") == batch[9] && !batch[9]->getHasMemoryAllocated());
+        std::cout << "✓ A batch is admitted up to available memory and the rest waits" << std::endl;
+        
+        for (int depth : stats.runQueueDepths) {
+            assert(depth == 2 && "A batch should be spread evenly across the core queues");
+        }
+        std::cout << "✓ Admitted processes are spread across the core queues" << std::endl;
+        
+        // Batches built off the clock still arrive on their trace ticks
+        const char* tracePath = "integration_arrivals.txt";
+        std::ofstream(tracePath) << "# tick count\n0 3\n5 2\n";
+        ProcessManager traced;
+        config.cpuTickMs = 1;
+        config.arrivalProcess = "trace";
+        config.arrivalTrace = tracePath;
+        traced.setConfig(config);
+        traced.setMemorySnapshotsEnabled(false);
+        traced.startScheduler();
+        traced.startProcessGeneration();
+        for (int wait = 0; wait < 200 && traced.getAllProcesses().size() < 5; ++wait) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        traced.stopProcessGeneration();
+        traced.haltScheduler();
+        std::remove(tracePath);
+        
+        auto arrivals = traced.getAllProcesses();
+        assert(arrivals.size() == 5 && "Every traced arrival should be generated");
+        uint64_t firstArrival = arrivals[0]->getArrivalTick();
+        int onFirst = 0;
+        for (auto& process : arrivals) {
+            firstArrival = std::min(firstArrival, process->getArrivalTick());
+        }
+        for (auto& process : arrivals) {
+            uint64_t offset = process->getArrivalTick() - firstArrival;
+            assert((offset == 0 || offset == 5) && "Arrivals should land on their trace ticks");
+            onFirst += offset == 0;
+        }
+        assert(onFirst == 3);
+        std::cout << "✓ Traced batches arrive on their ticks" << std::endl;
+        
+        std::cout << "Integration Test 7 PASSED" << std::endl;
+    }
 };
 
 // Demo function to show Phase 2 features
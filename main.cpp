@@ -1,6 +1,44 @@
 #include "ConsoleManager.h"
+#include "Simulator.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    // Headless mode: csopesy --simulate <config> --ticks N
+    std::string simulateConfig;
+    long long simulateTicks = -1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--simulate" && i + 1 < argc) {
+            simulateConfig = argv[++i];
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            try {
+                simulateTicks = std::stoll(argv[++i]);
+            } catch (...) {
+                simulateTicks = -1;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--simulate <config> --ticks N]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!simulateConfig.empty() || simulateTicks >= 0) {
+        if (simulateConfig.empty() || simulateTicks < 0) {
+            std::cerr << "Usage: " << argv[0] << " --simulate <config> --ticks N" << std::endl;
+            return 1;
+        }
+
+        Config config;
+        if (!ConsoleManager::loadConfig(simulateConfig, config)) {
+            std::cerr << "Invalid configuration: " << config.errorMessage << std::endl;
+            return 1;
+        }
+
+        Simulator simulator(config, static_cast<uint64_t>(simulateTicks));
+        return simulator.run();
+    }
 
-int main() {
     ConsoleManager manager;
     manager.run();
     return 0;